@@ -0,0 +1,65 @@
+// File: BKTree.cpp
+
+#include "BKTree.h"
+#include "CommandLine.h"
+#include <algorithm>
+
+namespace {
+
+std::size_t fullDistance(std::string_view a, std::string_view b) {
+    return editDistance(a, b, std::max(a.size(), b.size()));
+}
+
+} // namespace
+
+void BKTree::insert(Symbol name) {
+    std::string_view text = name.text();
+    if (nodes.empty()) {
+        nodes.push_back(Node{name, 0});
+        return;
+    }
+
+    std::uint32_t at = 0;
+    for (;;) {
+        std::size_t d = fullDistance(text, nodes[at].name.text());
+        if (d == 0) return;
+
+        std::uint32_t child = nodes[at].firstChild;
+        while (child != NO_NODE && nodes[child].distance != d) child = nodes[child].nextSibling;
+        if (child == NO_NODE) {
+            Node node{name, static_cast<std::uint32_t>(d)};
+            node.nextSibling = nodes[at].firstChild;
+            nodes[at].firstChild = static_cast<std::uint32_t>(nodes.size());
+            nodes.push_back(node);
+            return;
+        }
+        at = child;
+    }
+}
+
+void BKTree::search(std::string_view word, std::size_t limit, std::vector<Symbol> &found, Scratch &scratch) const {
+    found.clear();
+    if (nodes.empty()) return;
+
+    std::vector<std::uint32_t> &pending = scratch.pending;
+    std::vector<std::pair<std::size_t, Symbol>> &matches = scratch.matches;
+    matches.clear();
+    pending.assign(1, 0);
+    while (!pending.empty()) {
+        std::uint32_t at = pending.back();
+        pending.pop_back();
+
+        std::size_t d = fullDistance(word, nodes[at].name.text());
+        if (d <= limit) matches.emplace_back(d, nodes[at].name);
+
+        for (std::uint32_t child = nodes[at].firstChild; child != NO_NODE; child = nodes[child].nextSibling) {
+            std::size_t cd = nodes[child].distance;
+            if (cd + limit >= d && cd <= d + limit) pending.push_back(child);
+        }
+    }
+
+    std::sort(matches.begin(), matches.end(), [](const auto &a, const auto &b) {
+        return a.first != b.first ? a.first < b.first : a.second.text() < b.second.text();
+    });
+    for (const auto &m : matches) found.push_back(m.second);
+}
@@ -0,0 +1,55 @@
+// File: BKTree.h
+
+#ifndef ZOORK_BKTREE_H
+#define ZOORK_BKTREE_H
+
+#include "Symbol.h"
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+//
+//  Burkhard-Keller tree over names, for "did you mean" suggestions: finds
+//  every name within a few edits (see editDistance) of a misspelling while
+//  measuring the distance to only a small part of the vocabulary.
+//
+//  Each child of a node sits at a distinct distance from it; by the
+//  triangle inequality a search for names within `limit` of a word at
+//  distance d from a node need only enter children at d - limit .. d +
+//  limit.  Nodes live in one vector and link to their first child and next
+//  sibling, so a tree of a million names is a handful of allocations.
+//
+//  search() is const and keeps its working state in the caller's Scratch,
+//  so one tree can serve several threads once built.
+//
+class BKTree {
+public:
+    // Add a name; a name already in the tree is ignored
+    void insert(Symbol name);
+
+    // Working space for search(); keep one per thread or session and reuse it
+    struct Scratch {
+        std::vector<std::uint32_t> pending;
+        std::vector<std::pair<std::size_t, Symbol>> matches;
+    };
+
+    // Names within `limit` edits of `word`, closest first
+    void search(std::string_view word, std::size_t limit, std::vector<Symbol> &found, Scratch &scratch) const;
+
+    std::size_t size() const { return nodes.size(); }
+
+private:
+    static constexpr std::uint32_t NO_NODE = 0xffffffffu;
+
+    struct Node {
+        Symbol name;
+        std::uint32_t distance;      // from the parent
+        std::uint32_t firstChild = NO_NODE;
+        std::uint32_t nextSibling = NO_NODE;
+    };
+
+    std::vector<Node> nodes;
+};
+
+#endif // ZOORK_BKTREE_H
@@ -1,25 +1,34 @@
 // File: Combat.cpp
 
 #include "Combat.h"
+#include "EnemyFactory.h"
 #include <sstream>    // for std::istringstream
-#include <iostream>   // for std::cout
 #include <cmath>      // for std::ceil
 
-// Initialize the RNG once
-std::mt19937 Combatant::rng(std::random_device{}());
+static const char* bodyPartName(BodyPartType part) {
+    switch (part) {
+        case BodyPartType::Head:   return "head";
+        case BodyPartType::Thorax: return "thorax";
+        case BodyPartType::Arm:    return "arm";
+        case BodyPartType::Leg:    return "leg";
+    }
+    return "leg";
+}
 
 //
 //  Combatant implementation
 //
 
-Combatant::Combatant(const std::string& n, bool isPlayerCtrl)
+Combatant::Combatant(const std::string& n, bool isPlayerCtrl, SessionContext& context)
     : name(n),
       isPlayer(isPlayerCtrl),
       special(SpecialStat::None),
       inCover(false),
       flanking(false),
       flankCountdown(0),
-      distance(Distance::Medium) // default start at Medium
+      distance(Distance::Medium), // default start at Medium
+      rng(context.getRng()),
+      out(context.getOutput())
 {
     initBodyParts(false);
 }
@@ -101,7 +110,7 @@ bool Combatant::shootAt(std::shared_ptr<Combatant> target, BodyPartType targetPa
     if (!weapon || weapon->needsReload()) {
         return false; // can’t shoot
     }
-    if (!weapon->fireOne()) {
+    if (!weapon->fireOne(out)) {
         return false; // out of ammo
     }
 
@@ -126,12 +135,8 @@ bool Combatant::shootAt(std::shared_ptr<Combatant> target, BodyPartType targetPa
                 target->breakCover();
                 int damage = weapon->getDamage();
                 target->applyDamage(targetPart, damage);
-                std::cout << name << " shoots a bullet hitting your "
-                          << (targetPart == BodyPartType::Head    ? "head"
-                              : targetPart == BodyPartType::Thorax ? "thorax"
-                              : targetPart == BodyPartType::Arm    ? "arm"
-                                                                    : "leg")
-                          << " and breaking your cover!\n";
+                out.print("{} shoots a bullet hitting your {} and breaking your cover!\n",
+                          name, bodyPartName(targetPart));
 
                 // Check brutal death on any zeroed part
                 if (target->bodyParts.at(targetPart).hp == 0) {
@@ -144,10 +149,10 @@ bool Combatant::shootAt(std::shared_ptr<Combatant> target, BodyPartType targetPa
                     }
                 }
             } else {
-                std::cout << name << " fires at you but you remain safely behind cover.\n";
+                out.print("{} fires at you but you remain safely behind cover.\n", name);
             }
         } else {
-            std::cout << name << " fires at you and misses completely.\n";
+            out.print("{} fires at you and misses completely.\n", name);
         }
         return true;
     }
@@ -170,27 +175,14 @@ bool Combatant::shootAt(std::shared_ptr<Combatant> target, BodyPartType targetPa
         target->applyDamage(targetPart, damage);
 
         if (playerJustCoveredHit) {
-            std::cout << "You run to cover but get hit in the "
-                      << (targetPart == BodyPartType::Head    ? "head"
-                          : targetPart == BodyPartType::Thorax ? "thorax"
-                          : targetPart == BodyPartType::Arm    ? "arm"
-                                                                : "leg")
-                      << " as you get behind cover.\n";
+            out.print("You run to cover but get hit in the {} as you get behind cover.\n",
+                      bodyPartName(targetPart));
         } else {
             if (target->isPlayer) {
-                std::cout << attackerName << " hits you in the "
-                          << (targetPart == BodyPartType::Head    ? "head"
-                              : targetPart == BodyPartType::Thorax ? "thorax"
-                              : targetPart == BodyPartType::Arm    ? "arm"
-                                                                    : "leg")
-                          << ".\n";
+                out.print("{} hits you in the {}.\n", attackerName, bodyPartName(targetPart));
             } else {
-                std::cout << attackerName << " hits " << targetName << " in the "
-                          << (targetPart == BodyPartType::Head    ? "head"
-                              : targetPart == BodyPartType::Thorax ? "thorax"
-                              : targetPart == BodyPartType::Arm    ? "arm"
-                                                                    : "leg")
-                          << ".\n";
+                out.print("{} hits {} in the {}.\n",
+                          attackerName, targetName, bodyPartName(targetPart));
 
                 // If you hit an enemy while behind cover, force a guaranteed 1‐turn flank
                 if (attackerIsPlayer && inCover) {
@@ -210,36 +202,36 @@ bool Combatant::shootAt(std::shared_ptr<Combatant> target, BodyPartType targetPa
 
                     // Print a long, descriptive death message:
                     if (targetPart == BodyPartType::Head) {
-                        std::cout << targetName << " reels back as the bullet explodes through their skull, "
-                                     "blood spurting in a crimson arc. Their body goes limp, "
-                                     "eyes staring blankly as they collapse, spine folding unnaturally. "
-                                     "The crack of bone echoes, and a faint gurgle of blood spills from "
-                                     "their parted lips before silence descends.\n";
+                        out.print("{} reels back as the bullet explodes through their skull, "
+                                  "blood spurting in a crimson arc. Their body goes limp, "
+                                  "eyes staring blankly as they collapse, spine folding unnaturally. "
+                                  "The crack of bone echoes, and a faint gurgle of blood spills from "
+                                  "their parted lips before silence descends.\n", targetName);
                     } else if (targetPart == BodyPartType::Thorax) {
-                        std::cout << targetName << " clutches at their chest as the round tears through lungs. "
-                                     "They gasp desperately, froth bubbling at their mouth, crimson spray "
-                                     "misting in the air. Each breath becomes a ragged gasp; ribs fracture "
-                                     "with sickening cracks. They slump to a kneel, one hand pressed against "
-                                     "the smoking wound, eyes rolling back as they cough up dark blood, "
-                                     "choking in their final moments.\n";
+                        out.print("{} clutches at their chest as the round tears through lungs. "
+                                  "They gasp desperately, froth bubbling at their mouth, crimson spray "
+                                  "misting in the air. Each breath becomes a ragged gasp; ribs fracture "
+                                  "with sickening cracks. They slump to a kneel, one hand pressed against "
+                                  "the smoking wound, eyes rolling back as they cough up dark blood, "
+                                  "choking in their final moments.\n", targetName);
                     } else if (targetPart == BodyPartType::Arm) {
-                        std::cout << targetName << " howls as the bullet shreds their arm, bone "
-                                     "splintering, muscle and sinew rent. They clutch the mangled limb, "
-                                     "blood pouring in rivers down their side. Their knees buckle, body "
-                                     "seizing in shock; they scream, clutching the stump, white with pain, "
-                                     "tears mixing with sweat as they fall to the ground, arm twitching spasmodically.\n";
+                        out.print("{} howls as the bullet shreds their arm, bone "
+                                  "splintering, muscle and sinew rent. They clutch the mangled limb, "
+                                  "blood pouring in rivers down their side. Their knees buckle, body "
+                                  "seizing in shock; they scream, clutching the stump, white with pain, "
+                                  "tears mixing with sweat as they fall to the ground, arm twitching spasmodically.\n", targetName);
                     } else if (targetPart == BodyPartType::Leg) {
-                        std::cout << targetName << " collapses instantly, leg severed by the round. "
-                                     "They roar in agony, clawing at the stump as hot blood soaks the dirt. "
-                                     "Their other foot scrabbles in a futile attempt to stand; they rock "
-                                     "back and forth, screaming, bile rising as they choke on each breath. "
-                                     "Their torso trembles violently, eyes widening as they slip into unconsciousness.\n";
+                        out.print("{} collapses instantly, leg severed by the round. "
+                                  "They roar in agony, clawing at the stump as hot blood soaks the dirt. "
+                                  "Their other foot scrabbles in a futile attempt to stand; they rock "
+                                  "back and forth, screaming, bile rising as they choke on each breath. "
+                                  "Their torso trembles violently, eyes widening as they slip into unconsciousness.\n", targetName);
                     }
                 }
             }
         }
     } else {
-        std::cout << attackerName << " fired at " << targetName << " and missed.\n";
+        out.print("{} fired at {} and missed.\n", attackerName, targetName);
     }
     return true;
 }
@@ -247,30 +239,30 @@ bool Combatant::shootAt(std::shared_ptr<Combatant> target, BodyPartType targetPa
 void Combatant::reloadWeapon() {
     if (weapon) {
         std::string actor = isPlayer ? "You" : name;
-        std::cout << actor << " reloads the " << weapon->getName() << ".\n";
-        weapon->reload();
+        out.print("{} reloads the {}.\n", actor, weapon->getName());
+        weapon->reload(out);
     }
 }
 
 bool Combatant::attemptFlee() {
     if (distance != Distance::Far) {
         std::string actor = isPlayer ? "You" : name;
-        std::cout << actor << " can't flee unless you're far away!\n";
+        out.print("{} can't flee unless you're far away!\n", actor);
         return false;
     }
     if (bodyParts.at(BodyPartType::Leg).isBlackedOut()) {
         std::string actor = isPlayer ? "You" : name;
-        std::cout << actor << " tries to flee but legs are useless!\n";
+        out.print("{} tries to flee but legs are useless!\n", actor);
         return false;
     }
     std::uniform_real_distribution<double> uni(0.0, 1.0);
     if (uni(rng) < 0.5) {
         std::string actor = isPlayer ? "You" : name;
-        std::cout << actor << " successfully flees the combat!\n";
+        out.print("{} successfully flees the combat!\n", actor);
         return true;
     } else {
         std::string actor = isPlayer ? "You" : name;
-        std::cout << actor << " attempts to flee but fails!\n";
+        out.print("{} attempts to flee but fails!\n", actor);
         return false;
     }
 }
@@ -279,12 +271,13 @@ bool Combatant::attemptFlee() {
 //  Enemy implementation
 //
 
-Enemy::Enemy(EnemyType t)
+Enemy::Enemy(EnemyType t, SessionContext& context)
     : Combatant(
           (t == EnemyType::Scav
              ? "Scavenger"
              : (t == EnemyType::PMC_Chinese ? "PMC (C)" : "PMC (J)")),
-          false
+          false,
+          context
       ),
       enemyType(t)
 {
@@ -324,11 +317,11 @@ void Enemy::decideAction(std::shared_ptr<Combatant> player) {
     if (flanking) {
         flankCountdown--;
         if (flankCountdown > 0) {
-            std::cout << name << " is flanking...\n";
+            out.print("{} is flanking...\n", name);
             return;
         } else {
             flanking = false;
-            std::cout << name << " completes the flank maneuver and breaks your cover!\n";
+            out.print("{} completes the flank maneuver and breaks your cover!\n", name);
             player->breakCover();
             return;
         }
@@ -340,7 +333,7 @@ void Enemy::decideAction(std::shared_ptr<Combatant> player) {
         if (uni(rng) < 0.3) {
             flanking = true;
             flankCountdown = 1;  // one move to break cover
-            std::cout << name << " is attempting to flank you!\n";
+            out.print("{} is attempting to flank you!\n", name);
             return;
         }
     }
@@ -368,8 +361,8 @@ void Enemy::decideAction(std::shared_ptr<Combatant> player) {
 //  PlayerCombatant implementation
 //
 
-PlayerCombatant::PlayerCombatant(const std::string& n)
-    : Combatant(n, true), justTookCover(false)
+PlayerCombatant::PlayerCombatant(const std::string& n, SessionContext& context)
+    : Combatant(n, true, context), justTookCover(false)
 {
     initBodyParts(false);
     equipWeapon(WeaponFactory::createWeapon(WeaponType::Pistol));
@@ -377,59 +370,55 @@ PlayerCombatant::PlayerCombatant(const std::string& n)
 
 bool PlayerCombatant::attemptFlee() {
     if (distance != Distance::Far) {
-        std::cout << "You can't flee unless you're far away!\n";
+        out.append("You can't flee unless you're far away!\n");
         return false;
     }
     if (bodyParts.at(BodyPartType::Leg).isBlackedOut()) {
-        std::cout << "You try to flee but legs are gone!\n";
+        out.append("You try to flee but legs are gone!\n");
         return false;
     }
     return Combatant::attemptFlee();
 }
 
 void PlayerCombatant::displayStatus() const {
-    std::cout << "\n=== You Status ===\n";
-    std::cout << "Head: "   << bodyParts.at(BodyPartType::Head).hp   << "/" << bodyParts.at(BodyPartType::Head).maxHp   << "  |  "
-              << "Thorax: " << bodyParts.at(BodyPartType::Thorax).hp << "/" << bodyParts.at(BodyPartType::Thorax).maxHp << "  |  "
-              << "Arm: "    << bodyParts.at(BodyPartType::Arm).hp    << "/" << bodyParts.at(BodyPartType::Arm).maxHp    << "  |  "
-              << "Leg: "    << bodyParts.at(BodyPartType::Leg).hp    << "/" << bodyParts.at(BodyPartType::Leg).maxHp    << "\n";
-
-    std::cout << "Weapon: "
-              << (weapon ? weapon->getName() : "None")
-              << " [" << (weapon ? std::to_string(weapon->getAmmo()) + "/"
-                                + std::to_string(weapon->getMaxAmmo())
-                                : "N/A") << "]  |  "
-              << "Distance: "
-              << (distance == Distance::Close  ? "Close"
-                 : distance == Distance::Medium ? "Medium"
-                                                : "Far")
-              << "  |  "
-              << (inCover ? "Cover: Behind Cover" : "Cover: Exposed")
-              << "\n========================\n";
+    out.append("\n=== You Status ===\n");
+    out.print("Head: {}/{}  |  Thorax: {}/{}  |  Arm: {}/{}  |  Leg: {}/{}\n",
+              bodyParts.at(BodyPartType::Head).hp,   bodyParts.at(BodyPartType::Head).maxHp,
+              bodyParts.at(BodyPartType::Thorax).hp, bodyParts.at(BodyPartType::Thorax).maxHp,
+              bodyParts.at(BodyPartType::Arm).hp,    bodyParts.at(BodyPartType::Arm).maxHp,
+              bodyParts.at(BodyPartType::Leg).hp,    bodyParts.at(BodyPartType::Leg).maxHp);
+
+    if (weapon) {
+        out.print("Weapon: {} [{}/{}]", weapon->getName(), weapon->getAmmo(), weapon->getMaxAmmo());
+    } else {
+        out.append("Weapon: None [N/A]");
+    }
+    out.print("  |  Distance: {}  |  {}\n========================\n",
+              (distance == Distance::Close  ? "Close"
+              : distance == Distance::Medium ? "Medium"
+                                             : "Far"),
+              (inCover ? "Cover: Behind Cover" : "Cover: Exposed"));
 }
 
 //
 //  CombatManager implementation
 //
 
-bool CombatManager::allEnemiesDead(const std::vector<std::shared_ptr<Enemy>>& enemies) const {
+bool CombatManager::allEnemiesDead() const {
     for (auto& e : enemies) {
         if (!e->isDead()) return false;
     }
     return true;
 }
 
-void CombatManager::displayCombatants(
-    PlayerCombatant& player,
-    const std::vector<std::shared_ptr<Enemy>>& enemies
-) const {
-    player.displayStatus();
+void CombatManager::displayCombatants() const {
+    player->displayStatus();
 
-    std::cout << "\n=== Enemies ===\n";
+    out.append("\n=== Enemies ===\n");
     for (size_t i = 0; i < enemies.size(); ++i) {
         auto& e = enemies[i];
         if (e->isDead()) {
-            std::cout << i << ": " << e->getName() << "  |  Dead\n";
+            out.print("{}: {}  |  Dead\n", i, e->getName());
         } else {
             int headHp   = e->bodyParts.at(BodyPartType::Head).hp;
             int headMax  = e->bodyParts.at(BodyPartType::Head).maxHp;
@@ -440,214 +429,227 @@ void CombatManager::displayCombatants(
             int legHp    = e->bodyParts.at(BodyPartType::Leg).hp;
             int legMax   = e->bodyParts.at(BodyPartType::Leg).maxHp;
 
-            std::cout << i << ": " << e->getName() << "  |  "
-                      << "Head: " << headHp   << "/" << headMax   << "  |  "
-                      << "Th: "   << thorHp   << "/" << thorMax   << "  |  "
-                      << "A: "    << armHp    << "/" << armMax    << "  |  "
-                      << "L: "    << legHp    << "/" << legMax    << "\n";
+            out.print("{}: {}  |  Head: {}/{}  |  Th: {}/{}  |  A: {}/{}  |  L: {}/{}\n",
+                      i, e->getName(),
+                      headHp, headMax, thorHp, thorMax, armHp, armMax, legHp, legMax);
 
             // Compute player’s actual hit-chances (cover considered)
-            double dHead = player.calculateHitChance(BodyPartType::Head);
-            double dThor = player.calculateHitChance(BodyPartType::Thorax);
-            double dArm  = player.calculateHitChance(BodyPartType::Arm);
-            double dLeg  = player.calculateHitChance(BodyPartType::Leg);
+            double dHead = player->calculateHitChance(BodyPartType::Head);
+            double dThor = player->calculateHitChance(BodyPartType::Thorax);
+            double dArm  = player->calculateHitChance(BodyPartType::Arm);
+            double dLeg  = player->calculateHitChance(BodyPartType::Leg);
 
             int pctHead = static_cast<int>(std::ceil(dHead * 100));
             int pctThor = static_cast<int>(std::ceil(dThor * 100));
             int pctArm  = static_cast<int>(std::ceil(dArm  * 100));
             int pctLeg  = static_cast<int>(std::ceil(dLeg  * 100));
 
-            std::cout << "    Probabilities -> "
-                      << "H: "  << pctHead << "%  |  "
-                      << "T: "  << pctThor << "%  |  "
-                      << "A: "  << pctArm  << "%  |  "
-                      << "L: "  << pctLeg  << "%\n";
+            out.print("    Probabilities -> H: {}%  |  T: {}%  |  A: {}%  |  L: {}%\n",
+                      pctHead, pctThor, pctArm, pctLeg);
         }
     }
-    std::cout << "===============\n";
+    out.append("===============\n");
 }
 
-bool CombatManager::engage(
-    PlayerCombatant& player,
-    std::vector<std::shared_ptr<Enemy>>& enemies
+Task CombatManager::engage(
+    LineSource& input,
+    std::shared_ptr<PlayerCombatant> p,
+    std::vector<EnemyType> foes
 ) {
-    std::shared_ptr<Combatant> pPtr(&player, [](Combatant*) {});
-    this->playerPtr = pPtr;
+    player = std::move(p);
+    enemies.clear();
+    for (EnemyType type : foes) {
+        enemies.push_back(createEnemy(type, context));
+    }
 
     currentDistance = Distance::Far;
-    player.inCover = false;
-    player.distance = currentDistance;
+    player->inCover = false;
+    player->distance = currentDistance;
 
-    displayCombatants(player, enemies);
+    displayCombatants();
+    startPlayerTurn();
 
     while (true) {
-        if (!playerTurn(player, enemies)) {
-            return !player.isDead();
-        }
-        if (allEnemiesDead(enemies)) {
-            std::cout << "\nAll enemies are down. You survived!\n";
-            return true;
+        auto line = co_await input.nextLine();
+        if (!line) {
+            outcome = Outcome::InputClosed;
+            co_return;
         }
 
-        if (!enemiesTurn(player, enemies)) {
-            return false;
-        }
-        if (allEnemiesDead(enemies)) {
-            std::cout << "\nAll enemies are down. You survived!\n";
-            return true;
+        switch (applyPlayerAction(std::string(*line))) {
+            case Action::Invalid:
+                // Reprompt without the enemies acting
+                printActionMenu();
+                continue;
+            case Action::Fled:
+                outcome = player->isDead() ? Outcome::Lost : Outcome::Fled;
+                co_return;
+            case Action::Done:
+                break;
         }
 
-        displayCombatants(player, enemies);
+        if (finishRound()) co_return;
+
+        displayCombatants();
+        startPlayerTurn();
     }
 }
 
-bool CombatManager::playerTurn(
-    PlayerCombatant& player,
-    std::vector<std::shared_ptr<Enemy>>& enemies
-) {
-    player.tick();
-    return promptPlayerAction(player, enemies);
+// The enemies answer the player's action. Returns true (with `outcome` set)
+// once one side is down.
+bool CombatManager::finishRound() {
+    if (allEnemiesDead()) {
+        out.append("\nAll enemies are down. You survived!\n");
+        outcome = Outcome::Won;
+        return true;
+    }
+    if (!enemiesTurn()) {
+        outcome = Outcome::Lost;
+        return true;
+    }
+    if (allEnemiesDead()) {
+        out.append("\nAll enemies are down. You survived!\n");
+        outcome = Outcome::Won;
+        return true;
+    }
+    return false;
 }
 
-bool CombatManager::enemiesTurn(
-    PlayerCombatant& player,
-    const std::vector<std::shared_ptr<Enemy>>& enemies
-) {
+void CombatManager::startPlayerTurn() {
+    player->tick();
+    // Clear the "justTookCover" flag unless we explicitly go into Take Cover
+    player->justTookCover = false;
+    printActionMenu();
+}
+
+bool CombatManager::enemiesTurn() {
+    std::shared_ptr<Combatant> target = player;
     for (auto& e : enemies) {
         if (e->isDead()) continue;
-        e->decideAction(this->playerPtr);
-        if (player.isDead()) {
+        e->decideAction(target);
+        if (player->isDead()) {
             return false;
         }
     }
     return true;
 }
 
-bool CombatManager::promptPlayerAction(
-    PlayerCombatant& player,
-    std::vector<std::shared_ptr<Enemy>>& enemies
-) {
-    // Clear the "justTookCover" flag unless we explicitly go into Take Cover
-    player.justTookCover = false;
+void CombatManager::printActionMenu() const {
+    out.append("\nChoose an action:\n"
+               " 1) Move Closer   2) Move Further   3) Take Cover\n"
+               " 4) Shoot         5) Reload         6) Flee\n"
+               "Command> ");
+}
 
-    while (true) {
-        std::cout << "\nChoose an action:\n"
-                  << " 1) Move Closer   2) Move Further   3) Take Cover\n"
-                  << " 4) Shoot         5) Reload         6) Flee\n"
-                  << "Command> ";
-
-        std::string cmd;
-        std::getline(std::cin, cmd);
-
-        // 1) Move Closer
-        if (cmd == "1" || cmd == "move closer") {
-            bool wasInCover = player.isInCover();
-            if (currentDistance != Distance::Close) {
-                currentDistance = static_cast<Distance>(static_cast<int>(currentDistance) - 1);
-                player.distance = currentDistance;
-                if (wasInCover) {
-                    player.breakCover();
-                    std::cout << "You move closer and drop out of cover. You are now Exposed.\n";
-                } else {
-                    std::cout << "You move closer.\n";
-                }
+CombatManager::Action CombatManager::applyPlayerAction(const std::string& cmd) {
+    // 1) Move Closer
+    if (cmd == "1" || cmd == "move closer") {
+        bool wasInCover = player->isInCover();
+        if (currentDistance != Distance::Close) {
+            currentDistance = static_cast<Distance>(static_cast<int>(currentDistance) - 1);
+            player->distance = currentDistance;
+            if (wasInCover) {
+                player->breakCover();
+                out.append("You move closer and drop out of cover. You are now Exposed.\n");
             } else {
-                std::cout << "You are already at the closest range.\n";
+                out.append("You move closer.\n");
             }
-            return true;
+        } else {
+            out.append("You are already at the closest range.\n");
         }
-        // 2) Move Further
-        if (cmd == "2" || cmd == "move further") {
-            bool wasInCover = player.isInCover();
-            if (currentDistance != Distance::Far) {
-                currentDistance = static_cast<Distance>(static_cast<int>(currentDistance) + 1);
-                player.distance = currentDistance;
-                if (wasInCover) {
-                    player.breakCover();
-                    std::cout << "You move farther and drop out of cover. You are now Exposed.\n";
-                } else {
-                    std::cout << "You move farther.\n";
-                }
+        return Action::Done;
+    }
+    // 2) Move Further
+    if (cmd == "2" || cmd == "move further") {
+        bool wasInCover = player->isInCover();
+        if (currentDistance != Distance::Far) {
+            currentDistance = static_cast<Distance>(static_cast<int>(currentDistance) + 1);
+            player->distance = currentDistance;
+            if (wasInCover) {
+                player->breakCover();
+                out.append("You move farther and drop out of cover. You are now Exposed.\n");
             } else {
-                std::cout << "You are already at the farthest range.\n";
+                out.append("You move farther.\n");
             }
-            return true;
+        } else {
+            out.append("You are already at the farthest range.\n");
         }
-        // 3) Take Cover
-        if (cmd == "3" || cmd == "take cover") {
-            if (!player.isInCover()) {
-                player.takeCover();
-                player.justTookCover = true;
-                std::cout << "You run to cover. You are now Behind Cover.\n";
-            } else {
-                std::cout << "You are already behind cover.\n";
-            }
-            return true;
+        return Action::Done;
+    }
+    // 3) Take Cover
+    if (cmd == "3" || cmd == "take cover") {
+        if (!player->isInCover()) {
+            player->takeCover();
+            player->justTookCover = true;
+            out.append("You run to cover. You are now Behind Cover.\n");
+        } else {
+            out.append("You are already behind cover.\n");
+        }
+        return Action::Done;
+    }
+    // 4) Shoot
+    if (cmd.rfind("shoot", 0) == 0) {
+        std::istringstream iss(cmd);
+        std::vector<std::string> tokens;
+        std::string tok;
+        while (iss >> tok) {
+            tokens.push_back(tok);
         }
-        // 4) Shoot
-        if (cmd.rfind("shoot", 0) == 0) {
-            std::istringstream iss(cmd);
-            std::vector<std::string> tokens;
-            std::string tok;
-            while (iss >> tok) {
-                tokens.push_back(tok);
-            }
 
-            int idx = 0;
-            std::string partStr;
+        int idx = 0;
+        std::string partStr;
 
-            // shoot <part>
-            if (tokens.size() == 2) {
-                partStr = tokens[1];
-                if (enemies.size() > 1) {
-                    std::cout << "Multiple enemies present—use: shoot <enemyIndex> <bodyPart>\n";
-                    continue;  // reprompt
-                }
+        // shoot <part>
+        if (tokens.size() == 2) {
+            partStr = tokens[1];
+            if (enemies.size() > 1) {
+                out.append("Multiple enemies present—use: shoot <enemyIndex> <bodyPart>\n");
+                return Action::Invalid;  // reprompt
             }
-            // shoot <index> <part>
-            else if (tokens.size() == 3) {
-                try {
-                    idx = std::stoi(tokens[1]);
-                } catch (...) {
-                    std::cout << "Invalid enemy index.\n";
-                    continue;
-                }
-                partStr = tokens[2];
-                if (idx < 0 || idx >= static_cast<int>(enemies.size()) || enemies[idx]->isDead()) {
-                    std::cout << "Invalid enemy index.\n";
-                    continue;
-                }
+        }
+        // shoot <index> <part>
+        else if (tokens.size() == 3) {
+            try {
+                idx = std::stoi(tokens[1]);
+            } catch (...) {
+                out.append("Invalid enemy index.\n");
+                return Action::Invalid;
             }
-            else {
-                std::cout << "Usage: shoot <part>    OR    shoot <enemyIndex> <part>\n";
-                continue;
+            partStr = tokens[2];
+            if (idx < 0 || idx >= static_cast<int>(enemies.size()) || enemies[idx]->isDead()) {
+                out.append("Invalid enemy index.\n");
+                return Action::Invalid;
             }
-
-            BodyPartType targetPart = parseBodyPart(partStr);
-            auto enemyPtr = enemies[idx];
-            if (!player.shootAt(enemyPtr, targetPart)) {
-                std::cout << "Unable to shoot (no ammo or reloading).\n";
-            }
-            return true;
-        }
-        // 5) Reload
-        if (cmd == "5" || cmd == "reload") {
-            player.reloadWeapon();
-            return true;
         }
-        // 6) Flee
-        if (cmd == "6" || cmd == "flee") {
-            if (player.attemptFlee()) {
-                return false;  // you fled: exit combat loop
-            }
-            return true;      // failed to flee, still your enemies' turn
+        else {
+            out.append("Usage: shoot <part>    OR    shoot <enemyIndex> <part>\n");
+            return Action::Invalid;
         }
 
-        // Invalid input — reprompt without enemy acting
-        std::cout << "Unknown command. Try again.\n";
+        BodyPartType targetPart = parseBodyPart(partStr);
+        auto enemyPtr = enemies[idx];
+        if (!player->shootAt(enemyPtr, targetPart)) {
+            out.append("Unable to shoot (no ammo or reloading).\n");
+        }
+        return Action::Done;
+    }
+    // 5) Reload
+    if (cmd == "5" || cmd == "reload") {
+        player->reloadWeapon();
+        return Action::Done;
+    }
+    // 6) Flee
+    if (cmd == "6" || cmd == "flee") {
+        if (player->attemptFlee()) {
+            return Action::Fled;  // you fled: exit combat loop
+        }
+        return Action::Done;      // failed to flee, still your enemies' turn
     }
-}
 
+    // Invalid input — reprompt without enemy acting
+    out.append("Unknown command. Try again.\n");
+    return Action::Invalid;
+}
 
 BodyPartType CombatManager::parseBodyPart(const std::string& s) const {
     std::string u = s;
@@ -5,6 +5,9 @@
 
 #include "Weapons.h"     // must define Weapon, WeaponType, WeaponFactory
 #include "EnemyTypes.h"  // must define EnemyType
+#include "LineSource.h"
+#include "SessionContext.h"
+#include "Task.h"
 #include <map>
 #include <memory>
 #include <random>
@@ -42,7 +45,8 @@ struct BodyPart {
 class Combatant {
 public:
     // Constructor: name + whether “player‐controlled” or not
-    Combatant(const std::string& n, bool isPlayerCtrl);
+    // and the session it fights in (every roll and message goes through it)
+    Combatant(const std::string& n, bool isPlayerCtrl, SessionContext& context);
     virtual ~Combatant() = default;
 
     // Returns true if “dead” (Head or Thorax ≤ 0)
@@ -101,7 +105,8 @@ protected:
     SpecialStat special;
     std::shared_ptr<Weapon> weapon;
 
-    static std::mt19937 rng;
+    std::mt19937& rng;
+    OutputSink& out;
 };
 
 //
@@ -110,7 +115,7 @@ protected:
 //
 class Enemy : public Combatant {
 public:
-    explicit Enemy(EnemyType t);
+    Enemy(EnemyType t, SessionContext& context);
     void decideAction(std::shared_ptr<Combatant> player);
 
 private:
@@ -124,7 +129,7 @@ private:
 //
 class PlayerCombatant : public Combatant {
 public:
-    explicit PlayerCombatant(const std::string& n);
+    PlayerCombatant(const std::string& n, SessionContext& context);
 
     bool attemptFlee() override;
     void displayStatus() const;
@@ -134,26 +139,45 @@ public:
 };
 
 //
-//  CombatManager: orchestrates a turn‐based loop between one PlayerCombatant
-//  and a vector of Enemy instances. Returns true if player survives, false if dead.
+//  CombatManager: orchestrates a turn‐based fight between one PlayerCombatant
+//  and a vector of Enemy instances.  engage() is a coroutine that awaits each
+//  action line from `input`, so a session can sit suspended mid‐fight without
+//  holding a thread.  Enemies are spawned from the session's context.
 //
 class CombatManager {
 public:
-    bool engage(PlayerCombatant& player, std::vector<std::shared_ptr<Enemy>>& enemies);
+    enum class Outcome { Won, Lost, Fled, InputClosed };
+
+    explicit CombatManager(SessionContext& context)
+        : context(context), out(context.getOutput()) {}
+
+    // Fight until someone wins, the player flees, or the input runs out;
+    // then read the result with getOutcome().
+    Task engage(LineSource& input, std::shared_ptr<PlayerCombatant> player, std::vector<EnemyType> foes);
+    Outcome getOutcome() const { return outcome; }
 
 private:
-    bool allEnemiesDead(const std::vector<std::shared_ptr<Enemy>>& enemies) const;
-    void displayCombatants(PlayerCombatant& player, const std::vector<std::shared_ptr<Enemy>>& enemies) const;
-    bool playerTurn(PlayerCombatant& player, std::vector<std::shared_ptr<Enemy>>& enemies);
-    bool enemiesTurn(PlayerCombatant& player, const std::vector<std::shared_ptr<Enemy>>& enemies);
-    bool promptPlayerAction(PlayerCombatant& player, std::vector<std::shared_ptr<Enemy>>& enemies);
+    // Result of one player action line
+    enum class Action { Invalid, Done, Fled };
+
+    bool allEnemiesDead() const;
+    void displayCombatants() const;
+    void startPlayerTurn();
+    bool finishRound();
+    void printActionMenu() const;
+    Action applyPlayerAction(const std::string& cmd);
+    bool enemiesTurn();
     BodyPartType parseBodyPart(const std::string& s) const;
 
+    SessionContext& context;
+    OutputSink& out;
+
     // Distance is universal between player and all enemies:
-    Distance currentDistance;
+    Distance currentDistance = Distance::Far;
 
-    // We keep a shared_ptr to the real player so enemies can damage it directly:
-    std::shared_ptr<Combatant> playerPtr;
+    std::shared_ptr<PlayerCombatant> player;
+    std::vector<std::shared_ptr<Enemy>> enemies;
+    Outcome outcome = Outcome::InputClosed;
 };
 
 #endif // ZOORK_COMBAT_H
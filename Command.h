@@ -3,12 +3,13 @@
 #define ZOORK_COMMAND_H
 
 #include "GameObject.h"
+#include "OutputSink.h"
 
 class Command {
 public:
     explicit Command(GameObject* g) : gameObject(g) {}
     virtual ~Command() = default;
-    virtual void execute() = 0;
+    virtual void execute(OutputSink& out) = 0;
 protected:
     GameObject* gameObject;
 };
@@ -0,0 +1,162 @@
+// File: CommandJournal.cpp
+
+#include "CommandJournal.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr std::size_t FRAME_BYTES = 8;                // length + checksum
+constexpr std::size_t BODY_HEAD_BYTES = 1 + 8;        // kind + session id
+constexpr std::uint32_t MAX_BODY_BYTES = 1u << 20;
+
+std::uint32_t checksum(std::string_view bytes) {
+    std::uint32_t h = 2166136261u;
+    for (unsigned char c : bytes) {
+        h = (h ^ c) * 16777619u;
+    }
+    return h;
+}
+
+template <typename T>
+void appendRaw(std::string &out, const T &value) {
+    out.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T>
+T readRaw(const char *at) {
+    T value;
+    std::memcpy(&value, at, sizeof(T));
+    return value;
+}
+
+} // namespace
+
+CommandJournal::~CommandJournal() {
+    if (fd >= 0) {
+        commit();
+        ::close(fd);
+    }
+}
+
+bool CommandJournal::open(const std::string &path) {
+    int f = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (f < 0) return false;
+
+    // Read what is there to find the last session id and any torn tail
+    std::string image;
+    struct stat st;
+    if (::fstat(f, &st) != 0) {
+        ::close(f);
+        return false;
+    }
+    image.resize(static_cast<std::size_t>(st.st_size));
+    std::size_t got = 0;
+    while (got < image.size()) {
+        ssize_t n = ::pread(f, image.data() + got, image.size() - got, static_cast<off_t>(got));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) {
+            ::close(f);
+            return false;
+        }
+        got += static_cast<std::size_t>(n);
+    }
+
+    std::uint64_t lastSession = 0;
+    std::size_t valid = forEachRecord(image, [&](const Record &r) {
+        if (r.session > lastSession) lastSession = r.session;
+    });
+    if (valid < image.size() && ::ftruncate(f, static_cast<off_t>(valid)) != 0) {
+        ::close(f);
+        return false;
+    }
+    if (::lseek(f, 0, SEEK_END) < 0) {
+        ::close(f);
+        return false;
+    }
+
+    if (fd >= 0) ::close(fd);
+    fd = f;
+    nextSession = lastSession + 1;
+    pending.clear();
+    writeFailed = false;
+    return true;
+}
+
+void CommandJournal::append(RecordKind kind, std::uint64_t session, std::string_view payload) {
+    if (payload.size() > MAX_BODY_BYTES - BODY_HEAD_BYTES) {
+        payload = payload.substr(0, MAX_BODY_BYTES - BODY_HEAD_BYTES);
+    }
+    auto bodyLength = static_cast<std::uint32_t>(BODY_HEAD_BYTES + payload.size());
+    std::size_t frameAt = pending.size();
+
+    appendRaw(pending, bodyLength);
+    appendRaw(pending, std::uint32_t{0});
+    std::size_t bodyAt = pending.size();
+    pending.push_back(static_cast<char>(kind));
+    appendRaw(pending, session);
+    pending.append(payload);
+
+    std::uint32_t sum = checksum(std::string_view(pending).substr(bodyAt));
+    std::memcpy(pending.data() + frameAt + 4, &sum, sizeof(sum));
+}
+
+std::uint64_t CommandJournal::beginSession(std::uint32_t seed) {
+    std::uint64_t id = nextSession++;
+    append(RecordKind::Begin, id, std::string_view(reinterpret_cast<const char *>(&seed), sizeof(seed)));
+    return id;
+}
+
+void CommandJournal::recordLine(std::uint64_t session, std::string_view line) {
+    append(RecordKind::Line, session, line);
+}
+
+void CommandJournal::recordClose(std::uint64_t session) {
+    append(RecordKind::Close, session, {});
+}
+
+bool CommandJournal::commit() {
+    if (fd < 0 || writeFailed) return !writeFailed;
+    if (pending.empty()) return true;
+
+    const char *data = pending.data();
+    std::size_t left = pending.size();
+    while (left > 0) {
+        ssize_t n = ::write(fd, data, left);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            writeFailed = true;
+            break;
+        }
+        data += n;
+        left -= static_cast<std::size_t>(n);
+    }
+    if (!writeFailed && ::fdatasync(fd) != 0) writeFailed = true;
+    pending.clear();
+    return !writeFailed;
+}
+
+std::size_t CommandJournal::forEachRecord(std::string_view image, const std::function<void(const Record &)> &visit) {
+    std::size_t at = 0;
+    while (image.size() - at >= FRAME_BYTES) {
+        auto bodyLength = readRaw<std::uint32_t>(image.data() + at);
+        auto sum = readRaw<std::uint32_t>(image.data() + at + 4);
+        if (bodyLength < BODY_HEAD_BYTES || bodyLength > MAX_BODY_BYTES
+            || image.size() - at - FRAME_BYTES < bodyLength) {
+            break;
+        }
+        std::string_view body = image.substr(at + FRAME_BYTES, bodyLength);
+        if (checksum(body) != sum) break;
+
+        auto kind = static_cast<RecordKind>(static_cast<std::uint8_t>(body[0]));
+        if (kind != RecordKind::Begin && kind != RecordKind::Line && kind != RecordKind::Close) break;
+
+        Record record{kind, readRaw<std::uint64_t>(body.data() + 1), body.substr(BODY_HEAD_BYTES)};
+        visit(record);
+        at += FRAME_BYTES + bodyLength;
+    }
+    return at;
+}
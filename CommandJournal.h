@@ -0,0 +1,81 @@
+// File: CommandJournal.h
+
+#ifndef ZOORK_COMMANDJOURNAL_H
+#define ZOORK_COMMANDJOURNAL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+//
+//  Append-only log of everything that decides how a game plays out: the
+//  seed each session's RNG started from, then every input line the session
+//  consumed (commands, answers, combat actions), in order, and the end of
+//  its input.  Replaying those into a fresh SessionContext with the same
+//  seed reproduces the session's output byte for byte.
+//
+//  One journal is shared by all sessions.  Records are only buffered when
+//  they are made; commit() writes everything pending with one write() and
+//  makes it durable with one fdatasync(), so a server that commits once per
+//  event-loop pass pays one sync for all the sessions that ran in it.
+//
+//  Record layout (native byte order):
+//
+//      u32 body length, u32 FNV-1a of the body,
+//      body: u8 kind, u64 session id, payload
+//
+//  A record torn by a crash fails its length or checksum; open() cuts the
+//  file back to the last whole record.
+//
+class CommandJournal {
+public:
+    enum class RecordKind : std::uint8_t {
+        Begin = 1,   // payload: u32 RNG seed
+        Line  = 2,   // payload: the line, without its newline
+        Close = 3,   // no payload: the session's input ended
+    };
+
+    struct Record {
+        RecordKind kind;
+        std::uint64_t session;
+        std::string_view payload;
+    };
+
+    CommandJournal() = default;
+    ~CommandJournal();
+
+    CommandJournal(const CommandJournal &) = delete;
+    CommandJournal &operator=(const CommandJournal &) = delete;
+
+    // Open (or create) the journal at `path` for appending. New session ids
+    // continue after the highest one already in the file.
+    bool open(const std::string &path);
+    bool isOpen() const { return fd >= 0; }
+
+    // Start a new session whose RNG was seeded with `seed`; returns its id
+    std::uint64_t beginSession(std::uint32_t seed);
+    void recordLine(std::uint64_t session, std::string_view line);
+    void recordClose(std::uint64_t session);
+
+    // Write and sync everything recorded since the last commit. Returns
+    // false once anything failed to reach the disk.
+    bool commit();
+
+    std::size_t pendingBytes() const { return pending.size(); }
+
+    // Visit every whole record in a journal image, oldest first. Returns the
+    // length of the valid prefix (where a torn tail, if any, starts).
+    static std::size_t forEachRecord(std::string_view image, const std::function<void(const Record &)> &visit);
+
+private:
+    void append(RecordKind kind, std::uint64_t session, std::string_view payload);
+
+    int fd = -1;
+    std::uint64_t nextSession = 1;
+    std::string pending;
+    bool writeFailed = false;
+};
+
+#endif // ZOORK_COMMANDJOURNAL_H
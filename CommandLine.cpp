@@ -0,0 +1,104 @@
+// File: CommandLine.cpp
+
+#include "CommandLine.h"
+#include <algorithm>
+#include <cctype>
+
+namespace {
+
+bool isSpace(char c) {
+    return std::isspace(static_cast<unsigned char>(c)) != 0;
+}
+
+char toLower(char c) {
+    return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+}
+
+} // namespace
+
+void CommandLine::parse(std::string_view input) {
+    scratch.clear();
+    words.clear();
+
+    // Pass 1: copy the words, lowercased and separated by exactly one space
+    for (size_t i = 0; i < input.size();) {
+        while (i < input.size() && isSpace(input[i])) ++i;
+        if (i == input.size()) break;
+        if (!scratch.empty()) scratch.push_back(' ');
+        while (i < input.size() && !isSpace(input[i])) {
+            scratch.push_back(toLower(input[i++]));
+        }
+    }
+
+    // Pass 2: slice views once the buffer can no longer move
+    std::string_view text(scratch);
+    size_t start = 0;
+    while (start < text.size()) {
+        size_t end = text.find(' ', start);
+        if (end == std::string_view::npos) end = text.size();
+        words.push_back(text.substr(start, end - start));
+        start = end + 1;
+    }
+}
+
+CommandArgs CommandLine::arguments() const {
+    if (words.size() < 2) return {};
+    std::string_view text(scratch);
+    size_t offset = static_cast<size_t>(words[1].data() - text.data());
+    return {std::span<const std::string_view>(words).subspan(1), text.substr(offset)};
+}
+
+void lowercaseInPlace(std::string &s) {
+    for (char &c : s) c = toLower(c);
+}
+
+bool equalsLowercase(std::string_view name, std::string_view lower) {
+    if (name.size() != lower.size()) return false;
+    for (size_t i = 0; i < name.size(); ++i) {
+        if (toLower(name[i]) != lower[i]) return false;
+    }
+    return true;
+}
+
+size_t editDistance(std::string_view a, std::string_view b, size_t limit) {
+    if (a.size() > b.size()) std::swap(a, b);
+    if (b.size() - a.size() > limit) return limit + 1;
+
+    // Three rows of the optimal string alignment table, kept on the stack
+    // for names of ordinary length
+    constexpr size_t STACK_ROW = 64;
+    size_t stackRows[3][STACK_ROW + 1];
+    std::vector<size_t> heapRows;
+    size_t *rows[3];
+    if (a.size() <= STACK_ROW) {
+        for (int r = 0; r < 3; ++r) rows[r] = stackRows[r];
+    } else {
+        heapRows.resize(3 * (a.size() + 1));
+        for (int r = 0; r < 3; ++r) rows[r] = heapRows.data() + r * (a.size() + 1);
+    }
+
+    size_t *before = rows[0], *previous = rows[1], *current = rows[2];
+    for (size_t i = 0; i <= a.size(); ++i) previous[i] = i;
+    size_t previousMin = 0;
+    for (size_t j = 1; j <= b.size(); ++j) {
+        current[0] = j;
+        size_t rowMin = j;
+        for (size_t i = 1; i <= a.size(); ++i) {
+            size_t cost = a[i - 1] == b[j - 1] ? 0 : 1;
+            size_t d = std::min({previous[i] + 1, current[i - 1] + 1, previous[i - 1] + cost});
+            if (i > 1 && j > 1 && a[i - 1] == b[j - 2] && a[i - 2] == b[j - 1]) {
+                d = std::min(d, before[i - 2] + 1);
+            }
+            current[i] = d;
+            rowMin = std::min(rowMin, d);
+        }
+        // Later rows build on this one and (through a swap) the one before
+        if (rowMin > limit && previousMin > limit) return limit + 1;
+        previousMin = rowMin;
+        size_t *oldest = before;
+        before = previous;
+        previous = current;
+        current = oldest;
+    }
+    return std::min(previous[a.size()], limit + 1);
+}
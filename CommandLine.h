@@ -0,0 +1,61 @@
+// File: CommandLine.h
+
+#ifndef ZOORK_COMMANDLINE_H
+#define ZOORK_COMMANDLINE_H
+
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+//
+//  A run of words from a parsed command line.  `text` is the same words
+//  joined by single spaces, so handlers never have to rebuild it.
+//
+struct CommandArgs {
+    std::span<const std::string_view> words;
+    std::string_view text;
+
+    bool empty() const { return words.empty(); }
+    size_t size() const { return words.size(); }
+    std::string_view operator[](size_t i) const { return words[i]; }
+};
+
+//
+//  Splits an input line into lowercase words without allocating per word.
+//  The line is normalised (lowercased, single-spaced) into a scratch buffer
+//  owned by this object, and every view handed out points into it.  Keep one
+//  CommandLine per session and reuse it: once the buffers have grown to the
+//  longest line seen, parse() does not touch the heap again.
+//
+//  Views are valid until the next parse().
+//
+class CommandLine {
+public:
+    void parse(std::string_view input);
+
+    bool empty() const { return words.empty(); }
+    std::string_view verb() const { return words.empty() ? std::string_view() : words.front(); }
+
+    // Every word, verb included
+    CommandArgs all() const { return {words, scratch}; }
+
+    // Words after the verb
+    CommandArgs arguments() const;
+
+private:
+    std::string scratch;
+    std::vector<std::string_view> words;
+};
+
+// Lowercase ASCII letters of `s` in place.
+void lowercaseInPlace(std::string &s);
+
+// Compare `name` against an already-lowercase `lower`, ignoring case in `name`.
+bool equalsLowercase(std::string_view name, std::string_view lower);
+
+// Edits (insert, delete, replace, swap two neighbours) that turn `a` into
+// `b`, counting no further than `limit`: anything more is `limit + 1`.
+size_t editDistance(std::string_view a, std::string_view b, size_t limit);
+
+#endif // ZOORK_COMMANDLINE_H
@@ -0,0 +1,17 @@
+// ---------------------------------
+// File: EnemyFactory.h
+// ---------------------------------
+#ifndef ZOORK_ENEMY_FACTORY_H
+#define ZOORK_ENEMY_FACTORY_H
+
+#include "Combat.h"       // Defines Enemy, EnemyType
+#include "ObjectPool.h"
+#include <memory>
+
+// Simple helper: spawn a new Enemy of the given type for one session.
+// Enemies come from the calling thread's pool; one fight spawns and frees several.
+inline std::shared_ptr<Enemy> createEnemy(EnemyType type, SessionContext& context) {
+    return makePooled<Enemy>(type, context);
+}
+
+#endif // ZOORK_ENEMY_FACTORY_H
@@ -4,11 +4,28 @@
 #ifndef ZOORK_ENEMY_TYPES_H
 #define ZOORK_ENEMY_TYPES_H
 
-/// Three possible enemy “classes” in the war‐torn zone.
+#include <cstdint>
+#include <string_view>
+
+// Three possible enemy “classes” in the war‐torn zone.
 enum class EnemyType {
     Scav,
     PMC_Chinese,
     PMC_Japanese
 };
 
+inline constexpr std::uint32_t ENEMY_TYPE_COUNT = 3;
+
+// The type a world file names `name` ("Scav", "PMC_Chinese", "PMC_Japanese"); false if none.
+constexpr bool enemyTypeByName(std::string_view name, EnemyType &type) {
+    constexpr std::string_view NAMES[ENEMY_TYPE_COUNT] = {"Scav", "PMC_Chinese", "PMC_Japanese"};
+    for (std::uint32_t i = 0; i < ENEMY_TYPE_COUNT; ++i) {
+        if (NAMES[i] == name) {
+            type = static_cast<EnemyType>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
 #endif // ZOORK_ENEMY_TYPES_H
@@ -1,9 +1,8 @@
 // --- GameObject.cpp ---
 #include "GameObject.h"
 
-GameObject::GameObject(const std::string &n, const std::string &d) : name(n), description(d) {}
+GameObject::GameObject(const std::string &n, const std::string &d) : name(Symbol::intern(n)), description(d) {}
 
-std::string GameObject::getName() const { return name; }
-void GameObject::setName(const std::string &s) { name = s; }
-std::string GameObject::getDescription() const { return description; }
+void GameObject::setName(std::string_view s) { name = Symbol::intern(s); }
+std::string_view GameObject::getDescription() const { return description; }
 void GameObject::setDescription(const std::string &s) { description = s; }
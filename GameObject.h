@@ -2,18 +2,21 @@
 #ifndef ZOORK_GAMEOBJECT_H
 #define ZOORK_GAMEOBJECT_H
 
+#include "Symbol.h"
 #include <string>
+#include <string_view>
 
 class GameObject {
 public:
     GameObject(const std::string &, const std::string &);
-    std::string getName() const;
-    void setName(const std::string &);
-    std::string getDescription() const;
+    std::string_view getName() const { return name.text(); }
+    Symbol getSymbol() const { return name; }
+    void setName(std::string_view);
+    std::string_view getDescription() const;
     void setDescription(const std::string &);
 
 protected:
-    std::string name;
+    Symbol name;
     std::string description;
 };
 
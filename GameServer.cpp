@@ -0,0 +1,394 @@
+// File: GameServer.cpp
+
+#include "GameServer.h"
+#include "LineSource.h"
+#include "SessionSnapshot.h"
+#include "Task.h"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <string>
+#include <string_view>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+void logError(const char *what) {
+    std::cerr << "ZOOrkServer: " << what << ": " << std::strerror(errno) << "\n";
+}
+
+} // namespace
+
+struct GameServer::Session {
+    explicit Session(int fd_) : fd(fd_) {}
+
+    OutputSink &output() { return game->context.getOutput(); }
+    std::size_t pending() { return game ? output().size() : 0; }
+
+    int fd;
+    std::string input;             // received bytes not yet framed into lines
+    std::uint32_t interest = 0;    // events currently registered with epoll
+    bool peerClosed = false;
+    bool broken = false;           // socket error or protocol violation
+    std::uint64_t journalId = 0;
+
+    // Position in `resident`; no game (and not listed) while hibernated
+    std::list<Session *>::iterator residentPos;
+    std::chrono::steady_clock::time_point lastActive;
+
+    // Declared so the play() coroutine is destroyed before what it uses
+    std::unique_ptr<GameSession> game;   // world, context and engine, from the pool
+    PushLineSource lines;
+    Task play;                     // suspended whenever it waits for a line
+};
+
+GameServer::GameServer(Options opts, std::shared_ptr<const WorldManager> world)
+    : options(opts), port(opts.port),
+      pool(std::move(world), opts.idleSessions) {}
+
+GameServer::~GameServer() {
+    for (auto &kv : sessions) {
+        ::close(kv.first);
+    }
+    sessions.clear();
+    if (listenFd >= 0) ::close(listenFd);
+    if (epollFd >= 0) ::close(epollFd);
+}
+
+bool GameServer::start() {
+    listenFd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenFd < 0) {
+        logError("socket");
+        return false;
+    }
+    int one = 1;
+    ::setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(options.port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (::bind(listenFd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0) {
+        logError("bind");
+        return false;
+    }
+    if (::listen(listenFd, SOMAXCONN) < 0) {
+        logError("listen");
+        return false;
+    }
+    socklen_t len = sizeof(addr);
+    if (::getsockname(listenFd, reinterpret_cast<sockaddr *>(&addr), &len) == 0) {
+        port = ntohs(addr.sin_port);
+    }
+
+    if (!options.journalPath.empty() && !journal.open(options.journalPath)) {
+        logError("journal");
+        return false;
+    }
+    if (!options.spillDirectory.empty() && !spill.open(options.spillDirectory)) {
+        logError("spill file");
+        return false;
+    }
+
+    epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd < 0) {
+        logError("epoll_create1");
+        return false;
+    }
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = listenFd;
+    if (::epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &ev) < 0) {
+        logError("epoll_ctl");
+        return false;
+    }
+    return true;
+}
+
+void GameServer::run() {
+    constexpr int MAX_EVENTS = 256;
+    epoll_event events[MAX_EVENTS];
+
+    running = true;
+    while (running) {
+        // Wake up now and then so stop() from another thread is noticed
+        int n = ::epoll_wait(epollFd, events, MAX_EVENTS, 200);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            logError("epoll_wait");
+            break;
+        }
+        for (int i = 0; i < n; ++i) {
+            int fd = events[i].data.fd;
+            std::uint32_t ev = events[i].events;
+            if (fd == listenFd) {
+                acceptClients();
+                continue;
+            }
+            if (ev & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+                auto it = sessions.find(fd);
+                if (it != sessions.end()) onReadable(*it->second);
+            }
+            if (ev & EPOLLOUT) {
+                // Looked up again: reading may have closed the session
+                auto it = sessions.find(fd);
+                if (it != sessions.end()) onWritable(*it->second);
+            }
+        }
+
+        // Group commit: one sync covers every line run in this pass
+        if (journal.isOpen() && journal.pendingBytes() > 0 && !journal.commit()) {
+            logError("journal commit");
+            break;
+        }
+
+        hibernateIdle();
+    }
+}
+
+void GameServer::acceptClients() {
+    while (true) {
+        int fd = ::accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) logError("accept4");
+            return;
+        }
+        int one = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        openSession(fd);
+    }
+}
+
+void GameServer::openSession(int fd) {
+    auto owned = std::make_unique<Session>(fd);
+    Session &session = *owned;
+    sessions[fd] = std::move(owned);
+
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = fd;
+    if (::epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+        logError("epoll_ctl");
+        session.broken = true;
+    }
+    session.interest = EPOLLIN;
+
+    // A recycled (or new) game in the shared world, player at the start
+    session.game = pool.acquire();
+    if (journal.isOpen()) {
+        session.journalId = journal.beginSession(session.game->context.getSeed());
+        session.lines.journalTo(&journal, session.journalId);
+    }
+    session.residentPos = resident.insert(resident.begin(), &session);
+    session.lastActive = std::chrono::steady_clock::now();
+    session.play = session.game->engine.play(session.lines);
+    session.play.start();
+    flushOutput(session);
+    settle(session);
+}
+
+void GameServer::closeSession(Session &session) {
+    int fd = session.fd;
+    ::epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+
+    // The coroutine refers into the game, so it goes first
+    session.play = Task();
+    if (session.game) {
+        pool.release(std::move(session.game));
+        resident.erase(session.residentPos);
+    } else {
+        spill.drop(static_cast<std::uint64_t>(fd));
+    }
+    sessions.erase(fd);
+}
+
+void GameServer::onReadable(Session &session) {
+    char buf[16 * 1024];
+    while (!session.peerClosed && !session.broken) {
+        ssize_t n = ::recv(session.fd, buf, sizeof(buf), 0);
+        if (n > 0) {
+            session.input.append(buf, static_cast<size_t>(n));
+            // Do not slurp unboundedly while the game is not keeping up
+            if (session.input.size() > options.maxLineLength * 4) break;
+        } else if (n == 0) {
+            session.peerClosed = true;
+        } else if (errno == EINTR) {
+            continue;
+        } else {
+            if (errno != EAGAIN && errno != EWOULDBLOCK) session.broken = true;
+            break;
+        }
+    }
+    if (!session.game && !session.broken && !wake(session)) {
+        session.broken = true;
+    }
+    if (session.game) {
+        touch(session);
+        pump(session);
+    }
+    settle(session);
+}
+
+void GameServer::onWritable(Session &session) {
+    if (!session.game) return;
+    // Lines may be waiting because output backed up; they can run now
+    touch(session);
+    if (flushOutput(session)) pump(session);
+    settle(session);
+}
+
+void GameServer::touch(Session &session) {
+    session.lastActive = std::chrono::steady_clock::now();
+    resident.splice(resident.begin(), resident, session.residentPos);
+}
+
+void GameServer::hibernateIdle() {
+    if (!spill.isOpen()) return;
+    auto idleSince = std::chrono::steady_clock::now() - std::chrono::milliseconds(options.hibernateAfterMs);
+
+    // Oldest first; sessions that cannot be parked right now are skipped
+    auto it = resident.end();
+    while (it != resident.begin()) {
+        auto candidate = std::prev(it);
+        Session &session = **candidate;
+        if (resident.size() <= options.maxResident && session.lastActive > idleSince) break;
+        // Parked sessions leave the list, so `it` stays valid either way
+        if (!hibernate(session)) it = candidate;
+    }
+}
+
+bool GameServer::hibernate(Session &session) {
+    GameSession &game = *session.game;
+    if (session.broken || session.peerClosed || session.pending() > 0
+        || game.engine.isGameOver() || !game.engine.isAtCommandPrompt()) {
+        return false;
+    }
+    std::string image = SessionSnapshot::save(*pool.getWorld(), game.engine, game.context);
+    if (image.empty() || !spill.put(static_cast<std::uint64_t>(session.fd), image)) {
+        return false;
+    }
+
+    session.play = Task();
+    pool.release(std::move(session.game));
+    resident.erase(session.residentPos);
+    return true;
+}
+
+bool GameServer::wake(Session &session) {
+    std::string image;
+    if (!spill.take(static_cast<std::uint64_t>(session.fd), image)) return false;
+
+    session.game = pool.acquire();
+    GameSession &game = *session.game;
+    if (!SessionSnapshot::restore(image, *pool.getWorld(), game.engine, game.context)) {
+        pool.release(std::move(session.game));
+        return false;
+    }
+    session.residentPos = resident.insert(resident.begin(), &session);
+
+    // Already showed its prompt before it went to sleep
+    session.play = game.engine.resume(session.lines);
+    session.play.start();
+    return true;
+}
+
+void GameServer::pump(Session &session) {
+    // Run buffered lines for as long as the client keeps up with the output
+    do {
+        processInput(session);
+    } while (flushOutput(session) && hasRunnableInput(session));
+}
+
+bool GameServer::hasRunnableInput(const Session &session) const {
+    if (session.broken || session.game->engine.isGameOver()) return false;
+    return session.peerClosed || session.input.find('\n') != std::string::npos;
+}
+
+void GameServer::processInput(Session &session) {
+    if (session.broken) return;
+    ZOOrkEngine &engine = session.game->engine;
+
+    size_t consumed = 0;
+    while (!engine.isGameOver() && session.pending() < options.outputHighWater) {
+        size_t nl = session.input.find('\n', consumed);
+        if (nl == std::string::npos) break;
+        std::string_view line(session.input.data() + consumed, nl - consumed);
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+
+        session.lines.push(line);
+        consumed = nl + 1;
+    }
+    session.input.erase(0, consumed);
+
+    bool haveFullLine = session.input.find('\n') != std::string::npos;
+    if (!haveFullLine && session.input.size() > options.maxLineLength) {
+        session.broken = true;
+        return;
+    }
+
+    // Like std::getline at end of file: a last unterminated line still counts
+    if (session.peerClosed && !haveFullLine && !engine.isGameOver()) {
+        if (!session.input.empty()) {
+            std::string_view line(session.input);
+            if (line.back() == '\r') line.remove_suffix(1);
+            session.lines.push(line);
+            session.input.clear();
+        }
+        session.lines.close();
+    }
+}
+
+bool GameServer::flushOutput(Session &session) {
+    // Everything the game printed since the last flush goes out in one send
+    OutputSink &out = session.output();
+    while (!out.empty() && !session.broken) {
+        std::string_view text = out.view();
+        ssize_t n = ::send(session.fd, text.data(), text.size(), MSG_NOSIGNAL);
+        if (n > 0) {
+            out.consume(static_cast<size_t>(n));
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        } else {
+            session.broken = true;
+        }
+    }
+    return out.empty();
+}
+
+void GameServer::settle(Session &session) {
+    bool over = session.game && session.game->engine.isGameOver();
+    if (session.broken || (over && session.pending() == 0)) {
+        closeSession(session);
+        return;
+    }
+
+    std::uint32_t want = 0;
+    if (!over && !session.peerClosed && session.pending() < options.outputHighWater) {
+        want |= EPOLLIN;
+    }
+    if (session.pending() > 0) {
+        want |= EPOLLOUT;
+    }
+    if (want != session.interest) {
+        epoll_event ev{};
+        ev.events = want;
+        ev.data.fd = session.fd;
+        if (::epoll_ctl(epollFd, EPOLL_CTL_MOD, session.fd, &ev) < 0) {
+            logError("epoll_ctl");
+            closeSession(session);
+            return;
+        }
+        session.interest = want;
+    }
+}
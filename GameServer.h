@@ -0,0 +1,108 @@
+// File: GameServer.h
+
+#ifndef ZOORK_GAMESERVER_H
+#define ZOORK_GAMESERVER_H
+
+#include "CommandJournal.h"
+#include "SessionPool.h"
+#include "SpillFile.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+//
+//  Hosts many independent games over TCP on one thread.  All of them play
+//  in one read-only world; every connection gets its own GameSession
+//  (SessionContext with its world overlay, and a ZOOrkEngine) taken from a
+//  pool of finished games that are reset in place; bytes from the
+//  socket are framed into lines and pushed to the session's suspended game
+//  coroutine, which runs until it wants the next line.  All sockets are
+//  non-blocking and multiplexed with epoll.
+//
+//  Backpressure: once a session has more than `outputHighWater` bytes of
+//  unsent output, the server stops reading (and therefore stops running
+//  commands) for that session until the client drains it.
+//
+//  Journal: with a journal path set, every session's seed and input lines
+//  are recorded in one shared CommandJournal, committed (one write, one
+//  fdatasync) once per pass of the event loop for all sessions together.
+//
+//  Hibernation: a session idle at the command prompt for `hibernateAfterMs`,
+//  or the least recently used one while more than `maxResident` are in
+//  memory, is saved as a SessionSnapshot to an unlinked spill file and its
+//  game goes back to the pool.  Only its socket and unframed input stay
+//  resident.  The next bytes from the client restore it into a pooled game
+//  and carry on exactly where it left off.  Sessions in the middle of a
+//  fight or a question, or with output still unsent, stay resident.
+//
+class GameServer {
+public:
+    struct Options {
+        std::uint16_t port = 4000;           // 0 = pick any free port
+        std::size_t maxLineLength = 4096;    // longer lines drop the client
+        std::size_t outputHighWater = 256 * 1024;
+        std::size_t idleSessions = 256;      // finished games kept for reuse
+        std::string journalPath;             // empty = no journal
+        std::string spillDirectory = "/tmp"; // empty = never hibernate
+        unsigned hibernateAfterMs = 60 * 1000;
+        std::size_t maxResident = 1024;      // games kept in memory at most
+    };
+
+    // Every session plays in `world` (by default the built-in one)
+    explicit GameServer(Options options,
+                        std::shared_ptr<const WorldManager> world = std::make_shared<const WorldManager>());
+    ~GameServer();
+
+    GameServer(const GameServer &) = delete;
+    GameServer &operator=(const GameServer &) = delete;
+
+    // Bind 127.0.0.1:<port> and set up epoll. Returns false on failure.
+    bool start();
+
+    // Serve until stop() is called.
+    void run();
+
+    // Safe to call from a signal handler.
+    void stop() { running = false; }
+
+    // Port actually bound (useful with port 0)
+    std::uint16_t boundPort() const { return port; }
+
+    std::size_t sessionCount() const { return sessions.size(); }
+    std::size_t residentCount() const { return resident.size(); }
+
+private:
+    struct Session;
+
+    void acceptClients();
+    void openSession(int fd);
+    void closeSession(Session &session);
+    void onReadable(Session &session);
+    void onWritable(Session &session);
+    void pump(Session &session);
+    bool hasRunnableInput(const Session &session) const;
+    void processInput(Session &session);
+    bool flushOutput(Session &session);
+    void settle(Session &session);
+    void touch(Session &session);
+    void hibernateIdle();
+    bool hibernate(Session &session);
+    bool wake(Session &session);
+
+    Options options;
+    std::uint16_t port = 0;
+    int listenFd = -1;
+    int epollFd = -1;
+    std::atomic<bool> running{false};
+    SessionPool pool;
+    CommandJournal journal;
+    SpillFile spill;
+    std::list<Session *> resident;   // sessions with a game in memory, most recent first
+    std::unordered_map<int, std::unique_ptr<Session>> sessions;
+};
+
+#endif // ZOORK_GAMESERVER_H
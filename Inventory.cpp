@@ -1,129 +1,145 @@
 //Inventory.cpp
 #include "Inventory.h"
-#include "Item.h"
 #include <algorithm>
 
 Inventory::Inventory() {}
 
-bool Inventory::addItem(std::shared_ptr<Item> item) {
-    if (!item) return false;
-
-    ItemType type = item->getItemType();
-    if (type == ItemType::Weapon) {
-        if ((int)equippedWeapons.size() >= MAX_WEAPONS) {
-            return false;
-        }
-        equippedWeapons.push_back(item);
-    } else if (type == ItemType::Armor) {
-        equippedArmor = item;
+bool Inventory::addItem(const Item &item) {
+    ItemType type = item.getItemType();
+    if (type == ItemType::Weapon && weaponCount >= MAX_WEAPONS) {
+        return false;
+    }
+    if (count >= MAX_SLOTS) {
+        return false;
     }
 
-    if ((int)items.size() < MAX_SLOTS) {
-        items.push_back(item);
-        return true;
+    std::size_t slot = count++;
+    slots[slot] = item;
+    slots[slot].setEquipped(false);
+    names[slot] = item.getSymbol();
+    if (type == ItemType::Weapon || type == ItemType::Armor) {
+        setEquipped(slot, true);
     }
-    return false;
+    return true;
 }
 
-std::shared_ptr<Item> Inventory::removeItem(const std::string &itemName) {
+std::optional<Item> Inventory::removeItem(Symbol itemName) {
     auto idxOpt = findIndexByName(itemName);
-    if (!idxOpt) return nullptr;
-
-    size_t idx = *idxOpt;
-    auto removed = items[idx];
-    items.erase(items.begin() + idx);
-
-    // If it was equipped armor, unequip
-    if (equippedArmor && equippedArmor->getName() == itemName) {
-        equippedArmor.reset();
+    if (!idxOpt) return std::nullopt;
+
+    std::size_t slot = *idxOpt;
+    setEquipped(slot, false);
+    Item removed = slots[slot];
+
+    // Close the gap, keeping pick-up order, and renumber the equipped slots
+    std::copy(slots.begin() + slot + 1, slots.begin() + count, slots.begin() + slot);
+    std::copy(names.begin() + slot + 1, names.begin() + count, names.begin() + slot);
+    --count;
+    for (std::size_t i = 0; i < weaponCount; ++i) {
+        if (weaponSlots[i] > slot) --weaponSlots[i];
     }
-
-    // If it was an equipped weapon, remove from equippedWeapons
-    equippedWeapons.erase(
-        std::remove_if(
-            equippedWeapons.begin(),
-            equippedWeapons.end(),
-            [&](auto &w) { return w->getName() == itemName; }
-        ),
-        equippedWeapons.end()
-    );
+    if (armorSlot != NO_SLOT && armorSlot > slot) --armorSlot;
     return removed;
 }
 
-bool Inventory::hasItem(const std::string &itemName) const {
+bool Inventory::hasItem(Symbol itemName) const {
     return static_cast<bool>(findIndexByName(itemName));
 }
 
-std::shared_ptr<Item> Inventory::getItem(const std::string &itemName) const {
+Item *Inventory::getItem(Symbol itemName) {
     auto idxOpt = findIndexByName(itemName);
-    if (!idxOpt) return nullptr;
-    return items[*idxOpt];
+    return idxOpt ? &slots[*idxOpt] : nullptr;
 }
 
-std::vector<std::string> Inventory::listItemNames() const {
-    std::vector<std::string> names;
-    names.reserve(items.size());
-    for (const auto &it : items) {
-        names.push_back(it->getName());
-    }
-    return names;
+const Item *Inventory::getItem(Symbol itemName) const {
+    auto idxOpt = findIndexByName(itemName);
+    return idxOpt ? &slots[*idxOpt] : nullptr;
 }
 
-bool Inventory::equipArmor(const std::string &armorName) {
+bool Inventory::equipArmor(Symbol armorName) {
     auto idxOpt = findIndexByName(armorName);
     if (!idxOpt) return false;
-    size_t idx = *idxOpt;
-    if (items[idx]->getItemType() != ItemType::Armor) return false;
-    equippedArmor = items[idx];
+    if (slots[*idxOpt].getItemType() != ItemType::Armor) return false;
+    setEquipped(*idxOpt, true);
     return true;
 }
 
-bool Inventory::equipWeapon(const std::string &weaponName) {
-    if ((int)equippedWeapons.size() >= MAX_WEAPONS) return false;
+bool Inventory::equipWeapon(Symbol weaponName) {
+    if (weaponCount >= MAX_WEAPONS) return false;
     auto idxOpt = findIndexByName(weaponName);
     if (!idxOpt) return false;
-    size_t idx = *idxOpt;
-    if (items[idx]->getItemType() != ItemType::Weapon) return false;
-    equippedWeapons.push_back(items[idx]);
+    const Item &item = slots[*idxOpt];
+    if (item.getItemType() != ItemType::Weapon || item.isEquipped()) return false;
+    setEquipped(*idxOpt, true);
     return true;
 }
 
 bool Inventory::unequipArmor() {
-    if (!equippedArmor) return false;
-    equippedArmor.reset();
+    if (armorSlot == NO_SLOT) return false;
+    setEquipped(armorSlot, false);
     return true;
 }
 
-bool Inventory::unequipWeapon(const std::string &weaponName) {
-    auto it = std::find_if(
-        equippedWeapons.begin(),
-        equippedWeapons.end(),
-        [&](auto &w) { return w->getName() == weaponName; }
-    );
-    if (it == equippedWeapons.end()) return false;
-    equippedWeapons.erase(it);
-    return true;
+bool Inventory::unequipWeapon(Symbol weaponName) {
+    for (std::size_t i = 0; i < weaponCount; ++i) {
+        if (names[weaponSlots[i]] == weaponName) {
+            setEquipped(weaponSlots[i], false);
+            return true;
+        }
+    }
+    return false;
 }
 
 int Inventory::getArmorBonus() const {
-    return equippedArmor ? equippedArmor->getArmorBonus() : 0;
+    return armorSlot != NO_SLOT ? slots[armorSlot].getArmorBonus() : 0;
 }
 
-std::vector<std::shared_ptr<Item>> Inventory::getEquippedWeapons() const {
-    return equippedWeapons;
+void Inventory::clearAll() {
+    count = 0;
+    weaponCount = 0;
+    armorSlot = NO_SLOT;
 }
 
-void Inventory::clearAll() {
-    items.clear();
-    equippedWeapons.clear();
-    equippedArmor.reset();
+bool Inventory::restoreItem(Item item, bool equipped) {
+    if (count >= MAX_SLOTS) return false;
+
+    std::size_t slot = count++;
+    slots[slot] = item;
+    slots[slot].setEquipped(false);
+    names[slot] = item.getSymbol();
+    ItemType type = item.getItemType();
+    if (equipped && (type == ItemType::Armor || (type == ItemType::Weapon && weaponCount < MAX_WEAPONS))) {
+        setEquipped(slot, true);
+    }
+    return true;
 }
 
-std::optional<size_t> Inventory::findIndexByName(const std::string &name) const {
-    for (size_t i = 0; i < items.size(); ++i) {
-        if (items[i]->getName() == name) {
+std::optional<std::size_t> Inventory::findIndexByName(Symbol name) const {
+    for (std::size_t i = 0; i < count; ++i) {
+        if (names[i] == name) {
             return i;
         }
     }
     return std::nullopt;
 }
+
+// Mark `slot` equipped or not, keeping weaponSlots and armorSlot in step;
+// equipping armor takes off the armor worn before
+void Inventory::setEquipped(std::size_t slot, bool equipped) {
+    Item &item = slots[slot];
+    if (item.isEquipped() == equipped) return;
+
+    auto index = static_cast<std::uint8_t>(slot);
+    if (item.getItemType() == ItemType::Armor) {
+        if (equipped && armorSlot != NO_SLOT) slots[armorSlot].setEquipped(false);
+        armorSlot = equipped ? index : NO_SLOT;
+    } else if (equipped) {
+        weaponSlots[weaponCount++] = index;
+    } else {
+        auto end = weaponSlots.begin() + weaponCount;
+        auto at = std::find(weaponSlots.begin(), end, index);
+        std::copy(at + 1, end, at);
+        --weaponCount;
+    }
+    item.setEquipped(equipped);
+}
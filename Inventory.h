@@ -2,56 +2,78 @@
 #ifndef ZOORK_INVENTORY_H
 #define ZOORK_INVENTORY_H
 
-#include <memory>
+#include "Item.h"
+#include "Symbol.h"
+#include <array>
+#include <cstdint>
 #include <optional>
-#include <string>
-#include <vector>
-
-class Item;
+#include <span>
 
 static constexpr int MAX_SLOTS = 20;
 static constexpr int MAX_WEAPONS = 2;
 
+//
+//  Up to MAX_SLOTS items, held inline in pick-up order: an Inventory never
+//  touches the heap.  Each slot's name sits in a parallel array, so finding
+//  an item compares at most MAX_SLOTS 32-bit symbols in one cache line or
+//  two; the equipped weapons and armor are kept as slot numbers.
+//
 class Inventory {
 public:
     Inventory();
 
     // Add an item to inventory. Returns false if no space or too many weapons.
-    bool addItem(std::shared_ptr<Item> item);
-
-    // Remove an item by name; returns the removed shared_ptr or nullptr if not found.
-    std::shared_ptr<Item> removeItem(const std::string &itemName);
+    bool addItem(const Item &item);
 
-    // Check if inventory has an item with that name (by exact string match)
-    bool hasItem(const std::string &itemName) const;
+    // Remove an item by name; returns the removed item, or nothing if not found.
+    std::optional<Item> removeItem(Symbol itemName);
 
-    // Get an Item pointer by name (nullptr if missing)
-    std::shared_ptr<Item> getItem(const std::string &itemName) const;
+    // Check if inventory has an item with that name (exact, case included)
+    bool hasItem(Symbol itemName) const;
 
-    // List all item names currently in inventory:
-    std::vector<std::string> listItemNames() const;
+    // Get an Item pointer by name (nullptr if missing); valid until the
+    // next add or remove
+    Item *getItem(Symbol itemName);
+    const Item *getItem(Symbol itemName) const;
 
     // Equip/unequip (not strictly needed here, but kept for completeness)
-    bool equipArmor(const std::string &armorName);
-    bool equipWeapon(const std::string &weaponName);
+    bool equipArmor(Symbol armorName);
+    bool equipWeapon(Symbol weaponName);
     bool unequipArmor();
-    bool unequipWeapon(const std::string &weaponName);
+    bool unequipWeapon(Symbol weaponName);
 
     // If armor is equipped, return its bonus. Otherwise 0.
     int getArmorBonus() const;
 
-    // Return all currently equipped weapons
-    std::vector<std::shared_ptr<Item>> getEquippedWeapons() const;
+    // Slots (indexes into getItems()) of the equipped weapons, in the
+    // order they were equipped
+    std::span<const std::uint8_t> getEquippedWeapons() const { return {weaponSlots.data(), weaponCount}; }
 
     // Clear everything
     void clearAll();
 
+    // Everything carried, in pick-up order, and each item's name
+    std::span<const Item> getItems() const { return {slots.data(), count}; }
+    std::span<const Symbol> getNames() const { return {names.data(), count}; }
+
+    // Put back an item saved earlier, equipped or not, bypassing the
+    // pick-up rules (session snapshots). False if every slot is taken.
+    bool restoreItem(Item item, bool equipped);
+
 private:
-    std::optional<size_t> findIndexByName(const std::string &name) const;
+    static constexpr std::uint8_t NO_SLOT = 0xff;
+
+    std::optional<std::size_t> findIndexByName(Symbol name) const;
+    void setEquipped(std::size_t slot, bool equipped);
+
+    std::array<Item, MAX_SLOTS> slots;
+    std::array<Symbol, MAX_SLOTS> names;
+    std::uint8_t count = 0;
 
-    std::vector<std::shared_ptr<Item>> items;
-    std::vector<std::shared_ptr<Item>> equippedWeapons; // up to MAX_WEAPONS
-    std::shared_ptr<Item> equippedArmor;                // single armor slot
+    // Equipped items also carry the flag themselves
+    std::array<std::uint8_t, MAX_WEAPONS> weaponSlots{};
+    std::uint8_t weaponCount = 0;
+    std::uint8_t armorSlot = NO_SLOT;
 };
 
 #endif // ZOORK_INVENTORY_H
@@ -1,31 +1,39 @@
 //Item.cpp
 
 #include "Item.h"
+#include "ItemRegistry.h"
 
-//
-// Weapon‐backed constructor
-//
-Item::Item(const std::string &n, const std::string &desc, std::shared_ptr<Weapon> w)
-    : name(n), description(desc), itemType(ItemType::Weapon), weaponPtr(std::move(w)),
-      armorBonus(0), healAmount(0) { }
-
-//
-// Armor constructor
-//
-Item::Item(const std::string &n, const std::string &desc, int armorBonus_)
-    : name(n), description(desc), itemType(ItemType::Armor),
-      weaponPtr(nullptr), armorBonus(armorBonus_), healAmount(0) { }
-
-//
-// Medkit constructor
-//
-Item::Item(const std::string &n, const std::string &desc, int healAmount_, bool isMedkit)
-    : name(n), description(desc), itemType(ItemType::Medkit),
-      weaponPtr(nullptr), armorBonus(0), healAmount(healAmount_) { }
-
-//
-// Keycard or generic‐type constructor
-//
-Item::Item(const std::string &n, const std::string &desc, ItemType type_)
-    : name(n), description(desc), itemType(type_),
-      weaponPtr(nullptr), armorBonus(0), healAmount(0) { }
+Item::Item(std::uint16_t p) : prototype(p) {
+    if (getItemType() == ItemType::Weapon) ammo = static_cast<std::int16_t>(getPrototype().value);
+}
+
+const ItemPrototype& Item::getPrototype() const {
+    return ItemRegistry::getPrototype(prototype);
+}
+
+int Item::getArmorBonus() const {
+    return getItemType() == ItemType::Armor ? getPrototype().value : 0;
+}
+
+int Item::getHealAmount() const {
+    return getItemType() == ItemType::Medkit ? getPrototype().value : 0;
+}
+
+std::shared_ptr<Weapon> Item::makeWeapon() const {
+    auto weapon = WeaponFactory::createWeapon(getWeaponType());
+    weapon->restoreState(ammo, isReloading(), isScoped());
+    return weapon;
+}
+
+void Item::keepWeaponState(const Weapon& weapon) {
+    setWeaponState(weapon.getAmmo(), weapon.isReloading(), weapon.isScoped());
+}
+
+void Item::setWeaponState(int ammoLeft, bool reloading, bool scoped) {
+    ammo = static_cast<std::int16_t>(ammoLeft);
+    flags = static_cast<std::uint8_t>((flags & EQUIPPED) | (reloading ? RELOADING : 0) | (scoped ? SCOPED : 0));
+}
+
+void Item::setEquipped(bool equipped) {
+    flags = static_cast<std::uint8_t>(equipped ? flags | EQUIPPED : flags & ~EQUIPPED);
+}
@@ -2,51 +2,76 @@
 #ifndef ZOORK_ITEM_H
 #define ZOORK_ITEM_H
 
+#include "ItemTypes.h"
+#include "Symbol.h"
 #include "Weapons.h"
+#include <cstdint>
 #include <memory>
-#include <string>
+#include <string_view>
 
 //
-// All possible item categories:
+// What every item of one kind shares, kept once in the ItemRegistry
 //
-enum class ItemType { Weapon, Armor, Medkit, Keycard, Generic };
+struct ItemPrototype {
+    Symbol name;
+    std::string_view description;
+    ItemType type;
+    WeaponType weapon;   // for ItemType::Weapon
+    int value;           // armor bonus, heal amount or a weapon's full load of ammo
+};
 
+//
+// One item: which prototype it is, plus the little that can change (a
+// weapon's ammo, reload and scope state, and whether it is equipped).
+// A plain value of a few bytes, copied freely.
+//
 class Item {
 public:
-    // 1) Weapon‐backed constructor:
-    Item(const std::string &n, const std::string &desc, std::shared_ptr<Weapon> w);
-
-    // 2) Armor constructor (bonus = extra HP granted when equipped):
-    Item(const std::string &n, const std::string &desc, int armorBonus);
-
-    // 3) Medkit constructor (healAmount is how much it heals):
-    Item(const std::string &n, const std::string &desc, int healAmount, bool isMedkit);
+    // A new item of ItemRegistry prototype `prototype`; weapons come loaded
+    explicit Item(std::uint16_t prototype);
 
-    // 4) Keycard or Generic constructor:
-    Item(const std::string &n, const std::string &desc, ItemType type);
+    // No item at all, for fixed slot arrays to assign over
+    Item() = default;
 
-    const std::string& getName() const { return name; }
-    const std::string& getDescription() const { return description; }
-    ItemType getItemType() const { return itemType; }
+    std::uint16_t getPrototypeIndex() const { return prototype; }
+    const ItemPrototype& getPrototype() const;
 
-    // If this is weapon‐backed, returns its Weapon ptr; otherwise nullptr
-    std::shared_ptr<Weapon> getWeapon() const { return weaponPtr; }
+    Symbol getSymbol() const { return getPrototype().name; }
+    std::string_view getName() const { return getPrototype().name.text(); }
+    std::string_view getDescription() const { return getPrototype().description; }
+    ItemType getItemType() const { return getPrototype().type; }
 
     // If Armor, return its bonus; otherwise 0
-    int getArmorBonus() const { return armorBonus; }
+    int getArmorBonus() const;
 
     // If Medkit, return healing amount; otherwise 0
-    int getHealAmount() const { return healAmount; }
+    int getHealAmount() const;
+
+    // Weapon state (weapons only)
+    WeaponType getWeaponType() const { return getPrototype().weapon; }
+    int getAmmo() const { return ammo; }
+    bool isReloading() const { return (flags & RELOADING) != 0; }
+    bool isScoped() const { return (flags & SCOPED) != 0; }
+
+    // A Weapon in this item's state, for a fight, and that Weapon's state
+    // taken back afterwards
+    std::shared_ptr<Weapon> makeWeapon() const;
+    void keepWeaponState(const Weapon& weapon);
+    void setWeaponState(int ammoLeft, bool reloading, bool scoped);
+
+    bool isEquipped() const { return (flags & EQUIPPED) != 0; }
+    void setEquipped(bool equipped);
 
 private:
-    std::string name;
-    std::string description;
-    ItemType itemType = ItemType::Generic;
-
-    // Only one of these fields is non‐null / nonzero depending on type:
-    std::shared_ptr<Weapon> weaponPtr; // for ItemType::Weapon
-    int armorBonus = 0;                // for ItemType::Armor
-    int healAmount = 0;                // for ItemType::Medkit
+    static constexpr std::uint8_t RELOADING = 1;
+    static constexpr std::uint8_t SCOPED = 2;
+    static constexpr std::uint8_t EQUIPPED = 4;
+
+    std::uint16_t prototype = 0xffff;
+    std::int16_t ammo = 0;
+    std::uint8_t flags = 0;
 };
 
+static_assert(sizeof(Item) <= 8);
+
 #endif // ZOORK_ITEM_H
@@ -0,0 +1,125 @@
+// File: ItemRegistry.cpp
+
+#include "ItemRegistry.h"
+#include <array>
+#include <atomic>
+#include <bit>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+namespace {
+
+//
+//  Every prototype any world has defined, in the order they were added.
+//  Entries live in segments of FIRST_SEGMENT, 2 * FIRST_SEGMENT, ...
+//  entries that never move, and never change once published by bumping
+//  `count`, so get() reads them without the lock, as Symbol's table does.
+//
+class PrototypeTable {
+public:
+    const ItemPrototype &get(std::uint16_t index) const {
+        static const ItemPrototype NO_ITEM{};
+        return index < count.load(std::memory_order_acquire) ? entry(index) : NO_ITEM;
+    }
+
+    std::uint16_t add(const ItemPrototype &prototype) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto key = std::make_tuple(prototype.name.id(), prototype.description, prototype.type, prototype.weapon,
+                                   prototype.value);
+        auto it = index.find(key);
+        if (it != index.end()) return it->second;
+
+        std::uint16_t id = count.load(std::memory_order_relaxed);
+        if (id == ItemRegistry::NONE) return ItemRegistry::NONE;
+        std::size_t s = segmentOf(id);
+        if (!segments[s]) segments[s] = std::make_unique<ItemPrototype[]>(FIRST_SEGMENT << s);
+
+        ItemPrototype &added = segments[s][id - segmentStart(s)];
+        added = prototype;
+        added.description = descriptions.emplace_back(prototype.description);
+        std::get<1>(key) = added.description;
+        index.emplace(key, id);
+        count.store(static_cast<std::uint16_t>(id + 1), std::memory_order_release);
+        return id;
+    }
+
+private:
+    static constexpr std::size_t FIRST_SEGMENT = 64;
+    static constexpr std::size_t SEGMENTS = 11;   // more than NONE entries
+
+    static std::size_t segmentOf(std::size_t id) { return std::bit_width(id / FIRST_SEGMENT + 1) - 1; }
+    static std::size_t segmentStart(std::size_t s) { return FIRST_SEGMENT * ((std::size_t{1} << s) - 1); }
+
+    const ItemPrototype &entry(std::uint16_t id) const {
+        std::size_t s = segmentOf(id);
+        return segments[s][id - segmentStart(s)];
+    }
+
+    // Guards everything but the published entries
+    std::mutex mutex;
+    std::array<std::unique_ptr<ItemPrototype[]>, SEGMENTS> segments;
+    std::atomic<std::uint16_t> count{0};
+    std::deque<std::string> descriptions;   // what the entries' views point into
+    std::map<std::tuple<std::uint32_t, std::string_view, ItemType, WeaponType, int>, std::uint16_t> index;
+};
+
+PrototypeTable &prototypeTable() {
+    static PrototypeTable table;
+    return table;
+}
+
+} // namespace
+
+ItemRegistry::ItemRegistry(const WorldImage &image) {
+    const WorldImage::Header &header = image.header();
+
+    // Names are interned here, so every registered name is interned before
+    // the player can type it
+    for (std::uint32_t i = 0; i < header.itemCount; ++i) {
+        WorldImage::ItemRecord rec = image.item(i);
+        auto type = static_cast<ItemType>(rec.type);
+        auto weapon = static_cast<WeaponType>(rec.weapon);
+        // A weapon's value is the full magazine it comes with (its record's
+        // is always 0)
+        int value = type == ItemType::Weapon ? Weapon(weapon).getMaxAmmo() : rec.value;
+        std::uint16_t prototype = addPrototype(
+            ItemPrototype{Symbol::intern(image.text(rec.name)), image.text(rec.description), type, weapon, value});
+        if (prototype == NONE) continue;
+        byLookable.emplace(Symbol::intern(image.text(rec.object)), prototype);
+        byName.emplace(getPrototype(prototype).name, prototype);
+    }
+
+    for (std::uint32_t i = 0; i < header.spawnCount; ++i) {
+        WorldImage::SpawnRecord rec = image.spawn(i);
+        Symbol searchable = Symbol::intern(image.text(rec.searchable));
+        bySearchable[spawnKey(rec.room, searchable)].push_back(
+            ItemSpawn{image.text(rec.name), image.text(rec.look), image.text(rec.search)});
+    }
+}
+
+std::span<const ItemSpawn> ItemRegistry::findSpawns(RoomId room, Symbol searchable) const {
+    auto it = bySearchable.find(spawnKey(room, searchable));
+    return it != bySearchable.end() ? std::span<const ItemSpawn>(it->second) : std::span<const ItemSpawn>();
+}
+
+std::uint16_t ItemRegistry::findPrototype(Symbol lookable) const {
+    auto it = byLookable.find(lookable);
+    return it != byLookable.end() ? it->second : NONE;
+}
+
+std::uint16_t ItemRegistry::findPrototypeByName(Symbol name) const {
+    auto it = byName.find(name);
+    return it != byName.end() ? it->second : NONE;
+}
+
+const ItemPrototype &ItemRegistry::getPrototype(std::uint16_t index) {
+    return prototypeTable().get(index);
+}
+
+std::uint16_t ItemRegistry::addPrototype(const ItemPrototype &prototype) {
+    return prototypeTable().add(prototype);
+}
@@ -0,0 +1,79 @@
+// File: ItemRegistry.h
+
+#ifndef ZOORK_ITEMREGISTRY_H
+#define ZOORK_ITEMREGISTRY_H
+
+#include "Item.h"
+#include "RoomGraph.h"
+#include "Symbol.h"
+#include "WorldImage.h"
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Something a search turns up: it becomes lookable and searchable where
+// it was found.  The text is a view into the world's image.
+struct ItemSpawn {
+    std::string_view name;
+    std::string_view look;
+    std::string_view search;
+};
+
+//
+//  A world's pickups, built from its image (see the item and reveal lines
+//  of longxue.world): what each searchable object in each room reveals,
+//  and which lookable objects can be taken and as what.  Both are found by
+//  the object's interned name with one hash lookup, so "search" and "take"
+//  cost the same however many pickups the world has.
+//
+//  An Item holds only its prototype's number, so prototypes are not the
+//  world's but the process's: each item definition becomes one
+//  ItemPrototype as the world is loaded, shared with any other world
+//  defining the very same item.  Prototypes are never freed, so a process
+//  that keeps loading worlds with new items grows by one prototype per
+//  distinct item, and once it holds NONE of them further items load as
+//  things that cannot be taken.
+//
+//  Every member is safe to call from any thread; getPrototype() takes no
+//  lock.
+//
+class ItemRegistry {
+public:
+    static constexpr std::uint16_t NONE = 0xffff;
+
+    // No pickups at all
+    ItemRegistry() = default;
+
+    // The items and spawns of a validated image, whose text must outlive
+    // the registry
+    explicit ItemRegistry(const WorldImage &image);
+
+    // What searching `searchable` in room `room` turns up; empty if nothing
+    std::span<const ItemSpawn> findSpawns(RoomId room, Symbol searchable) const;
+
+    // Index of the prototype `lookable` is taken as, or NONE if it cannot
+    // be taken
+    std::uint16_t findPrototype(Symbol lookable) const;
+
+    // Index of the prototype whose item is called `name`, or NONE
+    std::uint16_t findPrototypeByName(Symbol name) const;
+
+    static const ItemPrototype &getPrototype(std::uint16_t index);
+
+private:
+    // Index of the prototype equal to `prototype` (its description is
+    // copied), adding it if new; NONE if the table is full
+    static std::uint16_t addPrototype(const ItemPrototype &prototype);
+
+    static std::uint64_t spawnKey(RoomId room, Symbol searchable) {
+        return (std::uint64_t{room} << 32) | searchable.id();
+    }
+
+    std::unordered_map<std::uint64_t, std::vector<ItemSpawn>> bySearchable;
+    std::unordered_map<Symbol, std::uint16_t> byLookable;
+    std::unordered_map<Symbol, std::uint16_t> byName;
+};
+
+#endif // ZOORK_ITEMREGISTRY_H
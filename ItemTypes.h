@@ -0,0 +1,52 @@
+// ---------------------------------
+// File: ItemTypes.h
+// ---------------------------------
+#ifndef ZOORK_ITEM_TYPES_H
+#define ZOORK_ITEM_TYPES_H
+
+#include <cstdint>
+#include <string_view>
+
+//
+// All possible item categories:
+//
+enum class ItemType { Weapon, Armor, Medkit, Keycard, Generic };
+
+// ——————————————
+// Four possible weapon types
+// ——————————————
+enum class WeaponType {
+    Rifle,
+    AssaultRifle,
+    Shotgun,
+    Pistol
+};
+
+inline constexpr std::uint32_t ITEM_TYPE_COUNT = 5;
+inline constexpr std::uint32_t WEAPON_TYPE_COUNT = 4;
+
+// The item type a world file names `name` ("Weapon", "Armor", ...); false if none.
+constexpr bool itemTypeByName(std::string_view name, ItemType &type) {
+    constexpr std::string_view NAMES[ITEM_TYPE_COUNT] = {"Weapon", "Armor", "Medkit", "Keycard", "Generic"};
+    for (std::uint32_t i = 0; i < ITEM_TYPE_COUNT; ++i) {
+        if (NAMES[i] == name) {
+            type = static_cast<ItemType>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+// The weapon type a world file names `name` ("Rifle", "AssaultRifle", ...); false if none.
+constexpr bool weaponTypeByName(std::string_view name, WeaponType &type) {
+    constexpr std::string_view NAMES[WEAPON_TYPE_COUNT] = {"Rifle", "AssaultRifle", "Shotgun", "Pistol"};
+    for (std::uint32_t i = 0; i < WEAPON_TYPE_COUNT; ++i) {
+        if (NAMES[i] == name) {
+            type = static_cast<WeaponType>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+#endif // ZOORK_ITEM_TYPES_H
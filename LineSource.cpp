@@ -0,0 +1,50 @@
+// File: LineSource.cpp
+
+#include "LineSource.h"
+#include "CommandJournal.h"
+#include <istream>
+#include <utility>
+
+void LineSource::wake() {
+    if (!waiting) return;
+    std::coroutine_handle<> h = std::exchange(waiting, {});
+    h.resume();
+}
+
+void LineSource::record(Status status, std::string_view line) {
+    if (status == Status::Ready) {
+        journal->recordLine(journalSession, line);
+    } else if (status == Status::Closed) {
+        journal->recordClose(journalSession);
+    }
+}
+
+LineSource::Status StreamLineSource::poll(std::string_view &line) {
+    if (pendingOutput) pendingOutput->flush();
+    if (!std::getline(input, buffer)) {
+        return Status::Closed;
+    }
+    line = buffer;
+    return Status::Ready;
+}
+
+void PushLineSource::push(std::string_view line) {
+    next.assign(line);
+    hasNext = true;
+    wake();
+}
+
+void PushLineSource::close() {
+    closed = true;
+    wake();
+}
+
+LineSource::Status PushLineSource::poll(std::string_view &line) {
+    if (hasNext) {
+        std::swap(current, next);
+        hasNext = false;
+        line = current;
+        return Status::Ready;
+    }
+    return closed ? Status::Closed : Status::Pending;
+}
@@ -0,0 +1,122 @@
+// File: LineSource.h
+
+#ifndef ZOORK_LINESOURCE_H
+#define ZOORK_LINESOURCE_H
+
+#include "OutputSink.h"
+#include <coroutine>
+#include <cstdint>
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <string_view>
+
+//
+//  Where a game session gets its input lines from.
+//
+//  `co_await source.nextLine()` yields the next line (without its newline),
+//  or std::nullopt once the input is closed.  The view stays valid until the
+//  next nextLine().  A source that has no line ready suspends the awaiting
+//  coroutine and resumes it when one arrives, so a session costs no thread
+//  while it waits.
+//
+//  With a journal attached, every line handed out (and the end of input)
+//  is also recorded there under the session's id.
+//
+class CommandJournal;
+
+class LineSource {
+public:
+    virtual ~LineSource() = default;
+
+    enum class Status { Ready, Pending, Closed };
+
+    class Awaiter {
+    public:
+        explicit Awaiter(LineSource &s) : source(s) {}
+
+        bool await_ready() {
+            status = source.poll(line);
+            return status != Status::Pending;
+        }
+        void await_suspend(std::coroutine_handle<> h) { source.waiting = h; }
+        std::optional<std::string_view> await_resume() {
+            // After a suspension the line has arrived (or the source closed)
+            if (status == Status::Pending) status = source.poll(line);
+            if (source.journal) source.record(status, line);
+            if (status == Status::Ready) return line;
+            return std::nullopt;
+        }
+
+    private:
+        LineSource &source;
+        Status status = Status::Pending;
+        std::string_view line;
+    };
+
+    Awaiter nextLine() { return Awaiter(*this); }
+
+    // Record consumed input to `j` (nullptr = stop recording)
+    void journalTo(CommandJournal *j, std::uint64_t session) {
+        journal = j;
+        journalSession = session;
+    }
+
+protected:
+    // Hand out the next line if there is one. A Ready line is consumed;
+    // polling again after Closed keeps returning Closed.
+    virtual Status poll(std::string_view &line) = 0;
+
+    // Resume the coroutine suspended in nextLine(), if any
+    void wake();
+
+private:
+    void record(Status status, std::string_view line);
+
+    std::coroutine_handle<> waiting;
+    CommandJournal *journal = nullptr;
+    std::uint64_t journalSession = 0;
+};
+
+//
+//  Reads lines from a stream with std::getline.  Never suspends: a blocking
+//  stream simply blocks, which is what the terminal and script modes want.
+//  If given a sink, it is flushed before each read so a waiting player sees
+//  everything up to the prompt.
+//
+class StreamLineSource : public LineSource {
+public:
+    explicit StreamLineSource(std::istream &in, OutputSink *flushBeforeRead = nullptr)
+        : input(in), pendingOutput(flushBeforeRead) {}
+
+protected:
+    Status poll(std::string_view &line) override;
+
+private:
+    std::istream &input;
+    OutputSink *pendingOutput;
+    std::string buffer;
+};
+
+//
+//  Lines are pushed in from outside (e.g. by the network server as they are
+//  framed off a socket).  Each push() runs the waiting session until it
+//  asks for another line; close() delivers end of input.
+//
+class PushLineSource : public LineSource {
+public:
+    // Only meaningful while a coroutine is waiting on nextLine()
+    void push(std::string_view line);
+    void close();
+
+protected:
+    Status poll(std::string_view &line) override;
+
+private:
+    std::string next;      // pushed, not yet handed out
+    std::string current;   // handed out; what the last view points into
+    bool hasNext = false;
+    bool closed = false;
+};
+
+#endif // ZOORK_LINESOURCE_H
@@ -8,5 +8,5 @@ Location::Location(const std::string &n, const std::string &d)
 Location::Location(const std::string &n, const std::string &d, std::shared_ptr<Command> c)
     : GameObject(n, d), enterCommand(std::move(c)) {}
 
-void Location::enter() { enterCommand->execute(); }
+void Location::enter(OutputSink& out) { enterCommand->execute(out); }
 void Location::setEnterCommand(std::shared_ptr<Command> c) { enterCommand = std::move(c); }
@@ -11,7 +11,7 @@ class Location : public GameObject {
 public:
     Location(const std::string &, const std::string &);
     Location(const std::string &, const std::string &, std::shared_ptr<Command>);
-    virtual void enter();
+    virtual void enter(OutputSink& out);
     void setEnterCommand(std::shared_ptr<Command>);
 protected:
     std::shared_ptr<Command> enterCommand;
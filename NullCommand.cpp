@@ -1,6 +1,6 @@
 //NullCommand.cpp
 #include "NullCommand.h"
 
-void NullCommand::execute() {
-    std::cout << "Nothing happens.\n";
+void NullCommand::execute(OutputSink& out) {
+    out.append("Nothing happens.\n");
 }
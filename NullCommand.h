@@ -3,7 +3,6 @@
 #define NULLCOMMAND_H
 
 #include "Command.h"
-#include <iostream>
 
 class NullCommand : public Command {
 public:
@@ -12,7 +11,7 @@ public:
     ~NullCommand() override = default;
 
     // Only declare execute() here (no inline body)
-    void execute() override;
+    void execute(OutputSink& out) override;
 };
 
 #endif // NULLCOMMAND_H
@@ -0,0 +1,108 @@
+// File: ObjectPool.h
+
+#ifndef ZOORK_OBJECTPOOL_H
+#define ZOORK_OBJECTPOOL_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+//
+//  Fixed-size blocks carved from slabs of SLAB_BLOCKS at a time, recycled
+//  through a free list.  One pool per block size and thread (see
+//  SlabPool::local), so taking and returning a block is a couple of pointer
+//  moves with no lock and no trip to the global allocator once the pool has
+//  grown to the thread's peak.
+//
+//  Slabs are only returned when the thread's pool is destroyed: objects
+//  from a pool must be released on the thread that made them, before it
+//  exits.  Every session lives on one thread, so this holds for the engine.
+//
+template <std::size_t Size, std::size_t Align>
+class SlabPool {
+public:
+    static constexpr std::size_t SLAB_BLOCKS = 64;
+
+    SlabPool() = default;
+    SlabPool(const SlabPool &) = delete;
+    SlabPool &operator=(const SlabPool &) = delete;
+
+    ~SlabPool() {
+        for (void *slab : slabs) ::operator delete(slab, std::align_val_t{ALIGN});
+    }
+
+    // The calling thread's pool
+    static SlabPool &local() {
+        thread_local SlabPool pool;
+        return pool;
+    }
+
+    void *allocate() {
+        if (!freeList) grow();
+        Block *block = freeList;
+        freeList = block->next;
+        return block;
+    }
+
+    void deallocate(void *p) {
+        Block *block = static_cast<Block *>(p);
+        block->next = freeList;
+        freeList = block;
+    }
+
+private:
+    union Block {
+        Block *next;
+        alignas(Align) unsigned char storage[Size];
+    };
+    static constexpr std::size_t ALIGN = alignof(Block);
+
+    void grow() {
+        Block *slab = static_cast<Block *>(::operator new(sizeof(Block) * SLAB_BLOCKS, std::align_val_t{ALIGN}));
+        slabs.push_back(slab);
+        for (std::size_t i = SLAB_BLOCKS; i-- > 0;) deallocate(slab + i);
+    }
+
+    Block *freeList = nullptr;
+    std::vector<void *> slabs;
+};
+
+//
+//  Standard allocator over SlabPool, for std::allocate_shared: the object
+//  and its control block come from the pool for their combined size.
+//  Requests for more than one object go to the global allocator.
+//
+template <typename T>
+struct PoolAllocator {
+    using value_type = T;
+
+    PoolAllocator() = default;
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U> &) {}
+
+    T *allocate(std::size_t n) {
+        if (n != 1) return std::allocator<T>().allocate(n);
+        return static_cast<T *>(SlabPool<sizeof(T), alignof(T)>::local().allocate());
+    }
+
+    void deallocate(T *p, std::size_t n) {
+        if (n != 1) {
+            std::allocator<T>().deallocate(p, n);
+            return;
+        }
+        SlabPool<sizeof(T), alignof(T)>::local().deallocate(p);
+    }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U> &) const { return true; }
+};
+
+// A shared T built in the calling thread's pool
+template <typename T, typename... Args>
+std::shared_ptr<T> makePooled(Args &&...args) {
+    return std::allocate_shared<T>(PoolAllocator<T>(), std::forward<Args>(args)...);
+}
+
+#endif // ZOORK_OBJECTPOOL_H
@@ -0,0 +1,67 @@
+// File: OutputSink.cpp
+
+#include "OutputSink.h"
+#include <cerrno>
+#include <unistd.h>
+
+OutputSink::~OutputSink() {
+    flush();
+}
+
+void OutputSink::attach(int fd_, std::size_t threshold) {
+    fd = fd_;
+    flushThreshold = fd_ >= 0 ? threshold : NO_THRESHOLD;
+}
+
+bool OutputSink::flush() {
+    if (fd < 0) return !writeFailed;
+    while (sent < buffer.size()) {
+        ssize_t n = ::write(fd, buffer.data() + sent, buffer.size() - sent);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            // Nobody is reading any more; drop the text rather than grow forever
+            buffer.clear();
+            sent = 0;
+            writeFailed = true;
+            return false;
+        }
+        sent += static_cast<std::size_t>(n);
+    }
+    buffer.clear();
+    sent = 0;
+    return !writeFailed;
+}
+
+void OutputSink::consume(std::size_t n) {
+    sent += n;
+    if (sent >= buffer.size()) {
+        buffer.clear();
+        sent = 0;
+    } else if (sent > buffer.size() / 2) {
+        // Keep the buffer from creeping forward forever under backpressure
+        buffer.erase(0, sent);
+        sent = 0;
+    }
+}
+
+void OutputSink::appendUntilPlaceholder(std::string_view &format) {
+    while (!format.empty()) {
+        std::size_t brace = format.find_first_of("{}");
+        if (brace == std::string_view::npos) {
+            buffer.append(format);
+            format = {};
+            return;
+        }
+        buffer.append(format.substr(0, brace));
+        // FormatString already checked that every brace is "{}", "{{" or "}}"
+        bool placeholder = format[brace] == '{' && format[brace + 1] == '}';
+        if (!placeholder) buffer.push_back(format[brace]);
+        format.remove_prefix(brace + 2);
+        if (placeholder) return;
+    }
+}
+
+void OutputSink::appendLiteral(std::string_view format) {
+    // No placeholders left, only escaped braces
+    appendUntilPlaceholder(format);
+}
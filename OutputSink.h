@@ -0,0 +1,142 @@
+// File: OutputSink.h
+
+#ifndef ZOORK_OUTPUTSINK_H
+#define ZOORK_OUTPUTSINK_H
+
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+//
+//  Format string for OutputSink::print().  Like std::format, each "{}" is
+//  replaced by the next argument and "{{" / "}}" stand for literal braces.
+//  The placeholder count is checked against the arguments at compile time.
+//
+namespace output_detail {
+
+// Not constexpr on purpose: calling it from a consteval context is a
+// compile error that names the problem.
+void formatStringDoesNotMatchArguments();
+
+consteval std::size_t countPlaceholders(std::string_view text) {
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        if (text[i] == '{') {
+            if (i + 1 < text.size() && text[i + 1] == '{') { ++i; continue; }
+            if (i + 1 < text.size() && text[i + 1] == '}') { ++i; ++count; continue; }
+            formatStringDoesNotMatchArguments();
+        } else if (text[i] == '}') {
+            if (i + 1 < text.size() && text[i + 1] == '}') { ++i; continue; }
+            formatStringDoesNotMatchArguments();
+        }
+    }
+    return count;
+}
+
+} // namespace output_detail
+
+template <typename... Args>
+struct FormatString {
+    template <typename S>
+        requires std::convertible_to<const S &, std::string_view>
+    consteval FormatString(const S &s) : text(s) {
+        if (output_detail::countPlaceholders(text) != sizeof...(Args)) {
+            output_detail::formatStringDoesNotMatchArguments();
+        }
+    }
+
+    std::string_view text;
+};
+
+//
+//  Everything one session prints goes into its OutputSink: a growable
+//  buffer that is handed to the terminal or socket in one piece instead of
+//  one `<<` fragment at a time.
+//
+//  A sink attached to a file descriptor writes itself out on flush() (and
+//  on its own once `flushThreshold` bytes pile up).  A sink without one is
+//  drained by its owner through view()/consume(), as the network server
+//  does with non-blocking sends.
+//
+class OutputSink {
+public:
+    static constexpr std::size_t NO_THRESHOLD = std::numeric_limits<std::size_t>::max();
+
+    OutputSink() = default;
+    ~OutputSink();
+
+    OutputSink(const OutputSink &) = delete;
+    OutputSink &operator=(const OutputSink &) = delete;
+
+    // Write to `fd` from now on (-1 = keep everything for the owner)
+    void attach(int fd, std::size_t flushThreshold = NO_THRESHOLD);
+
+    void append(std::string_view text) {
+        buffer.append(text);
+        if (buffer.size() >= flushThreshold) flush();
+    }
+    void append(char c) {
+        buffer.push_back(c);
+        if (buffer.size() >= flushThreshold) flush();
+    }
+
+    // print("{} reloads the {}.\n", actor, weapon->getName())
+    template <typename... Args>
+    void print(FormatString<std::type_identity_t<Args>...> format, const Args &...args) {
+        std::string_view rest = format.text;
+        (appendArgument(rest, args), ...);
+        appendLiteral(rest);
+        if (buffer.size() >= flushThreshold) flush();
+    }
+
+    // Write everything buffered to the attached fd with one write() (more
+    // only if the kernel takes a partial write). Returns false if this or
+    // any earlier write failed.
+    bool flush();
+
+    // Unsent text, for owners that drain the sink themselves
+    std::string_view view() const { return std::string_view(buffer).substr(sent); }
+    std::size_t size() const { return buffer.size() - sent; }
+    bool empty() const { return size() == 0; }
+    void consume(std::size_t n);
+
+    // Throw away anything not yet written or consumed
+    void clear() {
+        buffer.clear();
+        sent = 0;
+    }
+
+private:
+    // Copy literal text up to the next "{}" (consumed) into the buffer
+    void appendUntilPlaceholder(std::string_view &format);
+    void appendLiteral(std::string_view format);
+
+    template <typename T>
+    void appendArgument(std::string_view &format, const T &value) {
+        appendUntilPlaceholder(format);
+        appendValue(value);
+    }
+
+    void appendValue(std::string_view text) { buffer.append(text); }
+    void appendValue(char c) { buffer.push_back(c); }
+
+    template <typename T>
+        requires std::integral<T> && (!std::same_as<T, char>) && (!std::same_as<T, bool>)
+    void appendValue(T value) {
+        char digits[24];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        buffer.append(digits, result.ptr);
+    }
+
+    std::string buffer;
+    std::size_t sent = 0;            // prefix of buffer already consumed
+    int fd = -1;
+    std::size_t flushThreshold = NO_THRESHOLD;
+    bool writeFailed = false;
+};
+
+#endif // ZOORK_OUTPUTSINK_H
@@ -1,7 +0,0 @@
-// --- PassageDefaultEnterCommand.cpp ---
-#include "Passage.h"
-#include "PassageDefaultEnterCommand.h"
-
-void PassageDefaultEnterCommand::execute() {
-    static_cast<Passage*>(gameObject)->getTo()->enter();
-}
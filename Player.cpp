@@ -5,12 +5,7 @@
 #include <algorithm>
 
 //
-// Initialize static singleton pointer to nullptr
-//
-Player* Player::playerInstance = nullptr;
-
-//
-// private constructor
+// Constructor: every game session owns its own Player
 //
 Player::Player()
     : Character("You", "A lone survivor in the ruined city."),
@@ -22,16 +17,6 @@ Player::Player()
 {
 }
 
-//
-// Singleton accessor
-//
-Player* Player::instance() {
-    if (!playerInstance) {
-        playerInstance = new Player();
-    }
-    return playerInstance;
-}
-
 //
 // Setter/getter for player's current room
 //
@@ -43,6 +28,18 @@ Room* Player::getCurrentRoom() const {
     return currentRoom;
 }
 
+//
+// Reuse this Player for a new game
+//
+void Player::reset() {
+    currentRoom = nullptr;
+    inventory.clearAll();
+    headHealth = 50;
+    thoraxHealth = 200;
+    armsHealth = 150;
+    legsHealth = 150;
+}
+
 //
 // Called by Item::use(...) when an armor item is applied.
 // We simply add 'bonus' to thoraxHealth (capped at original max + bonus).
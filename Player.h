@@ -6,38 +6,44 @@
 #include "Room.h"
 #include "Inventory.h"
 #include <memory>
+#include <span>
 #include <string>
 #include <vector>
 
-// Forward‐declare Item so we can return shared_ptr<Item>
-class Item;
-
 class Player : public Character {
 public:
-    static Player *instance();
+    Player();
+    Player(const Player &) = delete;
+    Player &operator=(const Player &) = delete;
 
     void setCurrentRoom(Room *room);
     Room* getCurrentRoom() const;
 
+    // Back to a fresh player: empty inventory, full health, no room
+    void reset();
+
     // Inventory operations delegate to Inventory
-    bool pickUpItem(std::shared_ptr<Item> item) {
-        return inventory.addItem(std::move(item));
+    bool pickUpItem(const Item &item) {
+        return inventory.addItem(item);
     }
-    bool dropItem(const std::string &itemName) {
+    bool dropItem(Symbol itemName) {
         auto removed = inventory.removeItem(itemName);
         return static_cast<bool>(removed);
     }
 
     // Check if we have a named keycard
-    bool hasKeycard(const std::string &cardName) const {
+    bool hasKeycard(Symbol cardName) const {
         return inventory.hasItem(cardName);
     }
-    void useKeycard(const std::string &cardName) {
+    void useKeycard(Symbol cardName) {
         inventory.removeItem(cardName);
     }
 
     // Return a pointer to an Item in inventory (nullptr if missing)
-    std::shared_ptr<Item> getInventoryItem(const std::string &itemName) const {
+    Item *getInventoryItem(Symbol itemName) {
+        return inventory.getItem(itemName);
+    }
+    const Item *getInventoryItem(Symbol itemName) const {
         return inventory.getItem(itemName);
     }
 
@@ -46,16 +52,19 @@ public:
         return inventory.getArmorBonus();
     }
 
-    // Return currently equipped weapons
+    // Slots of the currently equipped weapons
     auto getEquippedWeapons() const {
         return inventory.getEquippedWeapons();
     }
 
-    // List all item names in inventory
-    std::vector<std::string> listInventory() const {
-        return inventory.listItemNames();
+    // Everything in inventory, in pick-up order
+    std::span<const Item> listInventory() const {
+        return inventory.getItems();
     }
 
+    Inventory& getInventory() { return inventory; }
+    const Inventory& getInventory() const { return inventory; }
+
     // Health fields
     int headHealth = 50;
     int thoraxHealth = 200;
@@ -68,13 +77,8 @@ public:
     void useMedkitHeal(int amount);
 
 private:
-    static Player *playerInstance;
     Room *currentRoom;
     Inventory inventory;
-
-    Player();
-    Player(const Player &) = delete;
-    Player &operator=(const Player &) = delete;
 };
 
 #endif // ZOORK_PLAYER_H
@@ -1,8 +1,7 @@
 //Room.cpp
 #include "Room.h"
 #include "RoomDefaultEnterCommand.h"
-#include "NullPassage.h"
-#include <iostream>
+#include <algorithm>
 
 //
 // Constructor #1: name + description.
@@ -26,74 +25,100 @@ Room::Room(const std::string &name, const std::string &desc, std::shared_ptr<Com
 // Add something the player can “look at” by name.
 //
 void Room::addLookable(const std::string &name, const std::string &lookDesc) {
-    lookables[name] = lookDesc;
+    addDetail(lookables, name, lookDesc);
 }
 
 //
 // Add something the player can “search” by name.
 //
 void Room::addSearchable(const std::string &name, const std::string &searchDesc) {
-    searchables[name] = searchDesc;
+    addDetail(searchables, name, searchDesc);
 }
 
-bool Room::isLookable(const std::string &name) const {
-    return lookables.find(name) != lookables.end();
+std::string_view Room::getDescription(const RoomContentStore::Handle &pin) const {
+    return pin ? pin->description : Location::getDescription();
 }
 
-bool Room::isSearchable(const std::string &name) const {
-    return searchables.find(name) != searchables.end();
+const std::vector<Room::Detail> &Room::lookList(const RoomContentStore::Handle &pin) const {
+    return pin ? pin->looks : lookables;
 }
 
-std::string Room::getLookDescription(const std::string &name) const {
-    auto it = lookables.find(name);
-    if (it != lookables.end()) {
-        return it->second;
-    }
-    return "";
+const std::vector<Room::Detail> &Room::searchList(const RoomContentStore::Handle &pin) const {
+    return pin ? pin->searches : searchables;
 }
 
-std::string Room::getSearchDescription(const std::string &name) const {
-    auto it = searchables.find(name);
-    if (it != searchables.end()) {
-        return it->second;
+void Room::addDetail(std::vector<Detail> &details, const std::string &name, const std::string &text) {
+    // Copies live in ownedText, which never moves them
+    ownedText.push_front(text);
+    std::string_view textView = ownedText.front();
+
+    auto it = std::lower_bound(details.begin(), details.end(), name,
+                               [](const Detail &d, std::string_view n) { return d.name < n; });
+    if (it != details.end() && it->name == name) {
+        it->text = textView;
+        return;
     }
-    return "";
+    ownedText.push_front(name);
+    details.insert(it, Detail{ownedText.front(), textView});
+}
+
+const Room::Detail *Room::findDetail(const std::vector<Detail> &details, std::string_view name) {
+    auto it = std::lower_bound(details.begin(), details.end(), name,
+                               [](const Detail &d, std::string_view n) { return d.name < n; });
+    return it != details.end() && it->name == name ? &*it : nullptr;
+}
+
+void Room::findDetails(const std::vector<Detail> &details, std::string_view prefix,
+                       std::vector<std::string_view> &names) {
+    auto it = std::lower_bound(details.begin(), details.end(), prefix,
+                               [](const Detail &d, std::string_view p) { return d.name < p; });
+    for (; it != details.end() && it->name.starts_with(prefix); ++it) names.push_back(it->name);
+}
+
+void Room::findLookables(std::string_view prefix, std::vector<std::string_view> &names) const {
+    findDetails(lookList(pinContent()), prefix, names);
+}
+
+void Room::findSearchables(std::string_view prefix, std::vector<std::string_view> &names) const {
+    findDetails(searchList(pinContent()), prefix, names);
+}
+
+bool Room::isLookable(std::string_view name) const {
+    return findDetail(lookList(pinContent()), name) != nullptr;
+}
+
+bool Room::isSearchable(std::string_view name) const {
+    return findDetail(searchList(pinContent()), name) != nullptr;
+}
+
+std::string_view Room::getLookDescription(std::string_view name) const {
+    const Detail *d = findDetail(lookList(pinContent()), name);
+    return d ? d->text : std::string_view();
+}
+
+std::string_view Room::getSearchDescription(std::string_view name) const {
+    const Detail *d = findDetail(searchList(pinContent()), name);
+    return d ? d->text : std::string_view();
 }
 
 std::vector<std::string> Room::getLookableNames() const {
+    RoomContentStore::Handle pin = pinContent();
+    const std::vector<Detail> &looks = lookList(pin);
     std::vector<std::string> names;
-    names.reserve(lookables.size());
-    for (const auto &kv : lookables) {
-        names.push_back(kv.first);
+    names.reserve(looks.size());
+    for (const Detail &d : looks) {
+        names.emplace_back(d.name);
     }
     return names;
 }
 
 std::vector<std::string> Room::getSearchableNames() const {
+    RoomContentStore::Handle pin = pinContent();
+    const std::vector<Detail> &searches = searchList(pin);
     std::vector<std::string> names;
-    names.reserve(searchables.size());
-    for (const auto &kv : searchables) {
-        names.push_back(kv.first);
+    names.reserve(searches.size());
+    for (const Detail &d : searches) {
+        names.emplace_back(d.name);
     }
     return names;
 }
-
-//
-// Passage‐related methods:
-//
-void Room::addPassage(const std::string &label, std::shared_ptr<Passage> p) {
-    passageMap[label] = std::move(p);
-}
-
-void Room::removePassage(const std::string &label) {
-    passageMap.erase(label);
-}
-
-std::shared_ptr<Passage> Room::getPassage(const std::string &label) {
-    if (passageMap.count(label)) {
-        return passageMap[label];
-    } else {
-        std::cout << "You can’t go directly to \"" << label << "\" from here.\n";
-        return std::make_shared<NullPassage>(this);
-    }
-}
@@ -3,13 +3,19 @@
 #define ZOORK_ROOM_H
 
 #include "Location.h"
-#include <map>
+#include "RoomContentStore.h"
+#include "RoomGraph.h"
+#include "WorldImage.h"
+#include <cstdint>
+#include <forward_list>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
-class Passage;
 class Command;
+class ItemRegistry;
+struct Encounter;
 
 class Room : public Location {
 public:
@@ -19,17 +25,48 @@ public:
     // Three‐argument constructor (name, description, custom enter command)
     Room(const std::string &name, const std::string &desc, std::shared_ptr<Command> c);
 
+    RoomId getId() const { return id; }
+    void setId(RoomId roomId) { id = roomId; }
+
+    // Number of the world's encounter waiting here, or RoomTriggers::NONE,
+    // and the encounter itself (nullptr if none); it must outlive the room
+    std::uint16_t getTrigger() const { return trigger; }
+    const Encounter *getEncounter() const { return encounter; }
+    void setTrigger(std::uint16_t index, const Encounter *e) {
+        trigger = index;
+        encounter = e;
+    }
+
+    // An object's name and its look or search text
+    using Detail = WorldImage::DetailText;
+
+    // Take the description and objects from `store` (the room's id is its
+    // key there), unpacked only when first needed; `store` must outlive
+    // the room. Rooms without a store keep their own text.
+    void setContentStore(RoomContentStore *store) { contentStore = store; }
+
+    // Keep this room's text in the store while the handle is held (null
+    // for a room without a store).  The views handed out below are only
+    // valid while the room is pinned; the engine pins a room for as long
+    // as it prints from it.
+    RoomContentStore::Handle pinContent() const { return contentStore ? contentStore->get(id) : nullptr; }
+
+    // The description, from `pin` (this room's pinned content) if there
+    // is one; the view lasts as long as the pin
+    std::string_view getDescription(const RoomContentStore::Handle &pin) const;
+
     // Add an object the player can “look at”
     void addLookable(const std::string &name, const std::string &lookDesc);
 
     // Add an object the player can “search”
     void addSearchable(const std::string &name, const std::string &searchDesc);
 
-    bool isLookable(const std::string &name) const;
-    bool isSearchable(const std::string &name) const;
+    bool isLookable(std::string_view name) const;
+    bool isSearchable(std::string_view name) const;
 
-    std::string getLookDescription(const std::string &name) const;
-    std::string getSearchDescription(const std::string &name) const;
+    // Empty if `name` is not there
+    std::string_view getLookDescription(std::string_view name) const;
+    std::string_view getSearchDescription(std::string_view name) const;
 
     // Return a list of all lookable object names
     std::vector<std::string> getLookableNames() const;
@@ -37,20 +74,44 @@ public:
     // Return a list of all searchable object names
     std::vector<std::string> getSearchableNames() const;
 
-    // Passage‐related methods (no change)
-    void addPassage(const std::string &label, std::shared_ptr<Passage> p);
-    void removePassage(const std::string &label);
-    std::shared_ptr<Passage> getPassage(const std::string &label);
+    // Append the names starting with `prefix`, in order (every name for
+    // an empty prefix); the views last as long as getLookDescription's
+    void findLookables(std::string_view prefix, std::vector<std::string_view> &names) const;
+    void findSearchables(std::string_view prefix, std::vector<std::string_view> &names) const;
+
+    // The world's passages (nullptr for a room outside any world); this
+    // room's exits are graph->getExits(getId())
+    const RoomGraph *getGraph() const { return graph; }
+    void setGraph(const RoomGraph *g) { graph = g; }
 
-    // Let engine iterate all adjacent passages
-    std::map<std::string, std::shared_ptr<Passage>> getAllExits() const { return passageMap; }
+    // What can be found and taken in this room's world (nullptr: nothing);
+    // it must outlive the room
+    const ItemRegistry *getItems() const { return items; }
+    void setItems(const ItemRegistry *registry) { items = registry; }
 
 private:
-    std::map<std::string, std::shared_ptr<Passage>> passageMap;
+    static const Detail *findDetail(const std::vector<Detail> &details, std::string_view name);
+    static void findDetails(const std::vector<Detail> &details, std::string_view prefix,
+                            std::vector<std::string_view> &names);
+    void addDetail(std::vector<Detail> &details, const std::string &name, const std::string &text);
+
+    // The objects, from `pin` (this room's pinned content) if there is one
+    const std::vector<Detail> &lookList(const RoomContentStore::Handle &pin) const;
+    const std::vector<Detail> &searchList(const RoomContentStore::Handle &pin) const;
+
+    const RoomGraph *graph = nullptr;
+    const ItemRegistry *items = nullptr;
+    RoomContentStore *contentStore = nullptr;
+
+    // Objects added with addLookable/addSearchable, each sorted by name;
+    // the views point into ownedText
+    std::vector<Detail> lookables;     // name → detailed “look” description
+    std::vector<Detail> searchables;   // name → detailed “search” description
+    std::forward_list<std::string> ownedText;
 
-    // Private maps for interactive objects
-    std::map<std::string, std::string> lookables;    // name → detailed “look” description
-    std::map<std::string, std::string> searchables;  // name → detailed “search” description
+    RoomId id = 0;
+    std::uint16_t trigger = 0xffff;
+    const Encounter *encounter = nullptr;
 };
 
 #endif //ZOORK_ROOM_H
@@ -0,0 +1,69 @@
+// File: RoomContentStore.cpp
+
+#include "RoomContentStore.h"
+#include <algorithm>
+#include <iterator>
+
+RoomContentStore::RoomContentStore(std::string_view validatedImage, std::size_t rooms)
+    : image(validatedImage), capacity(std::max<std::size_t>(rooms, 1)) {}
+
+RoomContentStore::Handle RoomContentStore::get(std::uint32_t id) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = index.find(id);
+    if (it != index.end()) {
+        ++hits;
+        entries.splice(entries.begin(), entries, it->second);
+        const std::shared_ptr<Entry> &entry = *it->second;
+        return Handle(entry, &entry->content);
+    }
+    ++misses;
+
+    // Make room by dropping the least recently used unpinned rooms
+    while (index.size() >= capacity && evictUnpinned()) {
+    }
+    auto entry = std::make_shared<Entry>();
+    entry->id = id;
+    reader.read(image, id, entry->buffer, entry->content);
+    entries.push_front(entry);
+    index.emplace(id, entries.begin());
+    return Handle(entry, &entry->content);
+}
+
+bool RoomContentStore::evictUnpinned() {
+    for (auto it = entries.end(); it != entries.begin();) {
+        --it;
+        if (it->use_count() == 1) {
+            index.erase((*it)->id);
+            entries.erase(it);
+            return true;
+        }
+    }
+    return false;
+}
+
+void RoomContentStore::setCapacity(std::size_t rooms) {
+    std::lock_guard<std::mutex> lock(mutex);
+    capacity = std::max<std::size_t>(rooms, 1);
+    while (index.size() > capacity && evictUnpinned()) {
+    }
+}
+
+std::size_t RoomContentStore::getCapacity() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return capacity;
+}
+
+std::size_t RoomContentStore::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return index.size();
+}
+
+std::uint64_t RoomContentStore::getHits() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return hits;
+}
+
+std::uint64_t RoomContentStore::getMisses() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return misses;
+}
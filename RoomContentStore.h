@@ -0,0 +1,77 @@
+// File: RoomContentStore.h
+
+#ifndef ZOORK_ROOMCONTENTSTORE_H
+#define ZOORK_ROOMCONTENTSTORE_H
+
+#include "WorldImage.h"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+//
+//  The text of a world's rooms (descriptions, look and search texts), kept
+//  packed in the world image and unpacked on first use.  Unpacked rooms
+//  stay in a least-recently-used cache of `capacity` rooms, shared by every
+//  session playing the world, so memory stays flat however large the world
+//  is and however many sessions wander through it.
+//
+//  get() hands out a Handle that pins the room: while any handle to it is
+//  held the room is never evicted, and the views in its Content stay valid.
+//  Pinned rooms may push the cache past its capacity for a while.  Every
+//  member is safe to call from several threads at once; one mutex guards
+//  the cache, and unpacking a missing room happens under it.
+//
+class RoomContentStore {
+public:
+    static constexpr std::size_t DEFAULT_CAPACITY = 4096;
+
+    using Handle = std::shared_ptr<const WorldImage::Content>;
+
+    // `image` must have passed WorldImage::validate() and outlive the store
+    explicit RoomContentStore(std::string_view image, std::size_t capacity = DEFAULT_CAPACITY);
+
+    // Content of room `id`, pinned while the handle is held; empty content
+    // if the room is damaged in the image
+    Handle get(std::uint32_t id);
+
+    // Rooms kept unpacked (at least one); shrinking evicts unpinned rooms
+    // at once
+    void setCapacity(std::size_t rooms);
+    std::size_t getCapacity() const;
+
+    std::size_t size() const;
+    std::uint64_t getHits() const;
+    std::uint64_t getMisses() const;
+
+private:
+    struct Entry {
+        std::uint32_t id;
+        std::string buffer;           // the unpacked bytes the views point into
+        WorldImage::Content content;
+    };
+
+    // Drop the least recently used room nobody holds a handle to; false if
+    // every room is pinned
+    bool evictUnpinned();
+
+    WorldImage image;
+    WorldImage::ContentReader reader;
+    std::size_t capacity;
+
+    // Most recently used first.  The cache's own reference is the only one
+    // to an unpinned entry, and new references are only made under `mutex`,
+    // so use_count() == 1 there means unpinned.  An evicted entry is freed
+    // by whichever holder lets go of it last.
+    mutable std::mutex mutex;
+    std::list<std::shared_ptr<Entry>> entries;
+    std::unordered_map<std::uint32_t, std::list<std::shared_ptr<Entry>>::iterator> index;
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+};
+
+#endif // ZOORK_ROOMCONTENTSTORE_H
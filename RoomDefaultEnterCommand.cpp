@@ -1,7 +1,11 @@
 // --- RoomDefaultEnterCommand.cpp ---
 #include "RoomDefaultEnterCommand.h"
-#include <iostream>
+#include "Room.h"
 
-void RoomDefaultEnterCommand::execute() {
-    std::cout << gameObject->getDescription() << "\n";
+RoomDefaultEnterCommand::RoomDefaultEnterCommand(Room* r) : Command(r), room(r) {}
+
+// Pins the room's text itself, so it is safe to run outside the engine
+void RoomDefaultEnterCommand::execute(OutputSink& out) {
+    RoomContentStore::Handle pin = room->pinContent();
+    out.print("{}\n", room->getDescription(pin));
 }
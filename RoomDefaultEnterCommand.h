@@ -4,10 +4,14 @@
 
 #include "Command.h"
 
+class Room;
+
 class RoomDefaultEnterCommand : public Command {
 public:
-    explicit RoomDefaultEnterCommand(GameObject* g) : Command(g) {}
-    void execute() override;
+    explicit RoomDefaultEnterCommand(Room* r);
+    void execute(OutputSink& out) override;
+private:
+    Room* room;
 };
 
 #endif //ZOORK_ROOMDEFAULTENTERCOMMAND_H
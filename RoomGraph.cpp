@@ -0,0 +1,81 @@
+// File: RoomGraph.cpp
+
+#include "RoomGraph.h"
+#include "RoomRouter.h"
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+RoomGraph::RoomGraph() : router(std::make_unique<RoomRouter>(*this)) {}
+RoomGraph::~RoomGraph() = default;
+
+RoomGraph::RoomGraph(RoomGraph &&other) noexcept
+    : rooms(std::move(other.rooms)), offsets(std::move(other.offsets)),
+      targets(std::move(other.targets)), labels(std::move(other.labels)), gated(std::move(other.gated)),
+      router(std::move(other.router)) {
+    if (router) router->graph = this;
+}
+
+RoomGraph &RoomGraph::operator=(RoomGraph &&other) noexcept {
+    rooms = std::move(other.rooms);
+    offsets = std::move(other.offsets);
+    targets = std::move(other.targets);
+    labels = std::move(other.labels);
+    gated = std::move(other.gated);
+    router = std::move(other.router);
+    if (router) router->graph = this;
+    return *this;
+}
+
+RoomGraph::RoomGraph(std::vector<Room *> r, std::vector<std::uint32_t> o,
+                     std::vector<RoomId> t, std::vector<Symbol> l, std::vector<bool> g)
+    : rooms(std::move(r)), offsets(std::move(o)), targets(std::move(t)), labels(std::move(l)), gated(std::move(g)) {
+    // Sort each room's exits by lowercased label (ties by label), keeping
+    // both arrays in step
+    auto byText = [](Symbol a, Symbol b) {
+        std::string_view la = a.lower().text();
+        std::string_view lb = b.lower().text();
+        return la != lb ? la < lb : a.text() < b.text();
+    };
+    std::vector<std::uint32_t> order;
+    std::vector<RoomId> sortedTargets;
+    std::vector<Symbol> sortedLabels;
+    for (std::size_t room = 0; room + 1 < offsets.size(); ++room) {
+        std::uint32_t first = offsets[room];
+        std::uint32_t last = offsets[room + 1];
+        if (std::is_sorted(labels.begin() + first, labels.begin() + last, byText)) continue;
+
+        order.resize(last - first);
+        std::iota(order.begin(), order.end(), first);
+        std::stable_sort(order.begin(), order.end(),
+                         [&](std::uint32_t a, std::uint32_t b) { return byText(labels[a], labels[b]); });
+        sortedTargets.clear();
+        sortedLabels.clear();
+        for (std::uint32_t e : order) {
+            sortedTargets.push_back(targets[e]);
+            sortedLabels.push_back(labels[e]);
+        }
+        std::copy(sortedTargets.begin(), sortedTargets.end(), targets.begin() + first);
+        std::copy(sortedLabels.begin(), sortedLabels.end(), labels.begin() + first);
+    }
+
+    router = std::make_unique<RoomRouter>(*this);
+}
+
+RoomId RoomGraph::findExit(RoomId from, Symbol lowerLabel) const {
+    std::span<const Symbol> exitLabels = getExitLabels(from);
+    std::string_view text = lowerLabel.text();
+    auto it = std::lower_bound(exitLabels.begin(), exitLabels.end(), text,
+                               [](Symbol label, std::string_view t) { return label.lower().text() < t; });
+    if (it == exitLabels.end() || it->lower() != lowerLabel) return NO_ROOM;
+    return targets[offsets[from] + (it - exitLabels.begin())];
+}
+
+std::pair<std::size_t, std::size_t> RoomGraph::findExitsByPrefix(RoomId from, std::string_view lowerPrefix) const {
+    std::span<const Symbol> exitLabels = getExitLabels(from);
+    auto first = std::lower_bound(exitLabels.begin(), exitLabels.end(), lowerPrefix,
+                                  [](Symbol label, std::string_view p) { return label.lower().text() < p; });
+    auto last = std::partition_point(first, exitLabels.end(),
+                                     [&](Symbol label) { return label.lower().text().starts_with(lowerPrefix); });
+    return {static_cast<std::size_t>(first - exitLabels.begin()), static_cast<std::size_t>(last - exitLabels.begin())};
+}
@@ -0,0 +1,87 @@
+// File: RoomGraph.h
+
+#ifndef ZOORK_ROOMGRAPH_H
+#define ZOORK_ROOMGRAPH_H
+
+#include "Symbol.h"
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+class Room;
+class RoomRouter;
+
+// Dense index of a room within its world (0 .. room count - 1)
+using RoomId = std::uint32_t;
+
+//
+//  The passages of a world in compressed sparse row form: the exits of
+//  room r are entries [offsets[r], offsets[r + 1]) of two parallel arrays,
+//  the destination RoomIds and the labels the player types to take them
+//  (in world images, the destination's name).  Each room's exits are
+//  sorted by lowercased label, so the exits a typed name or prefix can mean
+//  are found by binary search.
+//
+//  Walking the graph touches only the small contiguous targets array, so
+//  traversals and searches over large worlds stay in cache; the rooms and
+//  labels are only looked at when a step needs them.
+//
+class RoomGraph {
+public:
+    static constexpr RoomId NO_ROOM = 0xffffffffu;
+
+    RoomGraph();
+    ~RoomGraph();
+    // The router moves along with the graph; a moved-from graph is empty
+    // and has none
+    RoomGraph(RoomGraph &&other) noexcept;
+    RoomGraph &operator=(RoomGraph &&other) noexcept;
+
+    // `rooms` in id order; room r's exits are [offsets[r], offsets[r + 1])
+    // of `targets` and `labels`, in any order.  Rooms whose `gated` entry
+    // is set (see isGated) are never passed through by routes.  Builds the
+    // router too.
+    RoomGraph(std::vector<Room *> rooms, std::vector<std::uint32_t> offsets,
+              std::vector<RoomId> targets, std::vector<Symbol> labels, std::vector<bool> gated = {});
+
+    std::size_t getRoomCount() const { return rooms.size(); }
+    std::size_t getExitCount() const { return targets.size(); }
+
+    // nullptr if out of range
+    Room *getRoom(RoomId id) const { return id < rooms.size() ? rooms[id] : nullptr; }
+
+    // Entering the room may be refused or end the game, so a route may end
+    // there but never pass through it
+    bool isGated(RoomId id) const { return id < gated.size() && gated[id]; }
+
+    std::span<const RoomId> getExits(RoomId from) const {
+        return {targets.data() + offsets[from], targets.data() + offsets[from + 1]};
+    }
+    std::span<const Symbol> getExitLabels(RoomId from) const {
+        return {labels.data() + offsets[from], labels.data() + offsets[from + 1]};
+    }
+
+    // Destination of the exit of `from` whose label, lowercased, is
+    // `lowerLabel`; NO_ROOM if there is none
+    RoomId findExit(RoomId from, Symbol lowerLabel) const;
+
+    // The exits of `from` whose lowercased label starts with `lowerPrefix`,
+    // as [first, last) positions in getExits(from) and getExitLabels(from)
+    std::pair<std::size_t, std::size_t> findExitsByPrefix(RoomId from, std::string_view lowerPrefix) const;
+
+    // Routes and room lookup by name over this graph, safe to share
+    const RoomRouter &getRouter() const { return *router; }
+
+private:
+    std::vector<Room *> rooms;
+    std::vector<std::uint32_t> offsets;   // room count + 1 entries
+    std::vector<RoomId> targets;
+    std::vector<Symbol> labels;
+    std::vector<bool> gated;              // empty if no room is
+    std::unique_ptr<RoomRouter> router;
+};
+
+#endif // ZOORK_ROOMGRAPH_H
@@ -0,0 +1,190 @@
+// File: RoomRouter.cpp
+
+#include "RoomRouter.h"
+#include "Room.h"
+#include <algorithm>
+
+namespace {
+
+std::string_view lowerName(const RoomGraph &graph, RoomId id) {
+    return graph.getRoom(id)->getSymbol().lower().text();
+}
+
+} // namespace
+
+RoomRouter::RoomRouter(const RoomGraph &g) : graph(&g) {
+    byName.resize(graph->getRoomCount());
+    for (RoomId id = 0; id < byName.size(); ++id) byName[id] = id;
+    std::sort(byName.begin(), byName.end(),
+              [this](RoomId a, RoomId b) { return lowerName(*graph, a) < lowerName(*graph, b); });
+
+    if (graph->getRoomCount() <= TABLE_LIMIT) {
+        buildNextHops();
+    } else {
+        buildReverseEdges();
+    }
+}
+
+RoomId RoomRouter::findRoom(Symbol name) const {
+    std::span<const RoomId> rooms = findRoomsByPrefix(name.text());
+    return !rooms.empty() && graph->getRoom(rooms.front())->getSymbol().lower() == name ? rooms.front()
+                                                                                       : RoomGraph::NO_ROOM;
+}
+
+std::span<const RoomId> RoomRouter::findRoomsByPrefix(std::string_view lowerPrefix) const {
+    auto first = std::lower_bound(byName.begin(), byName.end(), lowerPrefix,
+                                  [this](RoomId id, std::string_view p) { return lowerName(*graph, id) < p; });
+    auto last = std::partition_point(first, byName.end(),
+                                     [&](RoomId id) { return lowerName(*graph, id).starts_with(lowerPrefix); });
+    return {first, last};
+}
+
+void RoomRouter::suggestRooms(std::string_view name, std::size_t limit, std::vector<RoomId> &rooms,
+                              Scratch &scratch) const {
+    std::call_once(nearNamesBuilt, [this] {
+        for (RoomId id : byName) nearNames.insert(graph->getRoom(id)->getSymbol().lower());
+    });
+    rooms.clear();
+    nearNames.search(name, limit, scratch.nearNames, scratch.near);
+    for (Symbol near : scratch.nearNames) rooms.push_back(findRoom(near));
+}
+
+void RoomRouter::buildNextHops() {
+    // One breadth-first search per room; every room reached inherits the
+    // first hop of the room it was reached from.  Gated rooms are reached
+    // but not gone on from.
+    const std::size_t n = graph->getRoomCount();
+    nextHops.assign(n * n, NO_HOP);
+    std::vector<RoomId> queue;
+    queue.reserve(n);
+    for (RoomId from = 0; from < n; ++from) {
+        std::uint16_t *row = nextHops.data() + from * n;
+        row[from] = static_cast<std::uint16_t>(from);
+        queue.clear();
+        for (RoomId to : graph->getExits(from)) {
+            if (row[to] != NO_HOP) continue;
+            row[to] = static_cast<std::uint16_t>(to);
+            if (!graph->isGated(to)) queue.push_back(to);
+        }
+        for (std::size_t head = 0; head < queue.size(); ++head) {
+            RoomId at = queue[head];
+            for (RoomId to : graph->getExits(at)) {
+                if (row[to] != NO_HOP) continue;
+                row[to] = row[at];
+                if (!graph->isGated(to)) queue.push_back(to);
+            }
+        }
+    }
+}
+
+void RoomRouter::buildReverseEdges() {
+    const std::size_t n = graph->getRoomCount();
+    reverseOffsets.assign(n + 1, 0);
+    for (RoomId from = 0; from < n; ++from) {
+        for (RoomId to : graph->getExits(from)) ++reverseOffsets[to + 1];
+    }
+    for (std::size_t i = 0; i < n; ++i) reverseOffsets[i + 1] += reverseOffsets[i];
+
+    reverseSources.resize(graph->getExitCount());
+    std::vector<std::uint32_t> fill(reverseOffsets.begin(), reverseOffsets.end() - 1);
+    for (RoomId from = 0; from < n; ++from) {
+        for (RoomId to : graph->getExits(from)) reverseSources[fill[to]++] = from;
+    }
+}
+
+bool RoomRouter::findRoute(RoomId from, RoomId to, std::vector<RoomId> &route, Scratch &scratch) const {
+    route.clear();
+    if (from == to) return true;
+    if (nextHops.empty()) return searchBothWays(from, to, route, scratch);
+
+    const std::size_t n = graph->getRoomCount();
+    for (RoomId at = from; at != to;) {
+        std::uint16_t hop = nextHops[at * n + to];
+        if (hop == NO_HOP) return false;
+        at = hop;
+        route.push_back(at);
+    }
+    return true;
+}
+
+bool RoomRouter::searchBothWays(RoomId from, RoomId to, std::vector<RoomId> &route, Scratch &scratch) const {
+    std::vector<std::uint32_t> &forwardMark = scratch.forwardMark;
+    std::vector<std::uint32_t> &backwardMark = scratch.backwardMark;
+    std::vector<RoomId> &forwardParent = scratch.forwardParent;
+    std::vector<RoomId> &backwardParent = scratch.backwardParent;
+    std::vector<RoomId> &frontier = scratch.frontier;
+    std::vector<RoomId> &backFrontier = scratch.backFrontier;
+    std::vector<RoomId> &nextFrontier = scratch.nextFrontier;
+    std::uint32_t &search = scratch.search;
+
+    // Marks wrapped around, or the scratch is new to this world: start
+    // them over
+    const std::size_t n = graph->getRoomCount();
+    if (++search == 0 || forwardMark.size() != n) {
+        forwardMark.assign(n, 0);
+        backwardMark.assign(n, 0);
+        forwardParent.assign(n, RoomGraph::NO_ROOM);
+        backwardParent.assign(n, RoomGraph::NO_ROOM);
+        search = 1;
+    }
+
+    forwardMark[from] = search;
+    backwardMark[to] = search;
+    frontier.assign(1, from);
+    backFrontier.assign(1, to);
+
+    // Grow the smaller side by one whole level at a time.  The first
+    // passage found from a room seen forwards to one seen backwards closes
+    // a shortest route: any shorter one would have met a level earlier.
+    // Gated rooms are never added to either side, so the only ones a
+    // route can touch are its ends.
+    RoomId meetFrom = RoomGraph::NO_ROOM;
+    RoomId meetTo = RoomGraph::NO_ROOM;
+    while (!frontier.empty() && !backFrontier.empty() && meetFrom == RoomGraph::NO_ROOM) {
+        nextFrontier.clear();
+        if (frontier.size() <= backFrontier.size()) {
+            for (std::size_t i = 0; i < frontier.size() && meetFrom == RoomGraph::NO_ROOM; ++i) {
+                RoomId at = frontier[i];
+                for (RoomId next : graph->getExits(at)) {
+                    if (backwardMark[next] == search) {
+                        meetFrom = at;
+                        meetTo = next;
+                        break;
+                    }
+                    if (forwardMark[next] == search || graph->isGated(next)) continue;
+                    forwardMark[next] = search;
+                    forwardParent[next] = at;
+                    nextFrontier.push_back(next);
+                }
+            }
+            frontier.swap(nextFrontier);
+        } else {
+            for (std::size_t i = 0; i < backFrontier.size() && meetFrom == RoomGraph::NO_ROOM; ++i) {
+                RoomId at = backFrontier[i];
+                for (std::uint32_t e = reverseOffsets[at]; e < reverseOffsets[at + 1]; ++e) {
+                    RoomId previous = reverseSources[e];
+                    if (forwardMark[previous] == search) {
+                        meetFrom = previous;
+                        meetTo = at;
+                        break;
+                    }
+                    if (backwardMark[previous] == search || graph->isGated(previous)) continue;
+                    backwardMark[previous] = search;
+                    backwardParent[previous] = at;
+                    nextFrontier.push_back(previous);
+                }
+            }
+            backFrontier.swap(nextFrontier);
+        }
+    }
+    if (meetFrom == RoomGraph::NO_ROOM) return false;
+
+    // from .. meetFrom (reversed off the parents), then meetTo .. to
+    for (RoomId at = meetFrom; at != from; at = forwardParent[at]) route.push_back(at);
+    std::reverse(route.begin(), route.end());
+    for (RoomId at = meetTo;; at = backwardParent[at]) {
+        route.push_back(at);
+        if (at == to) break;
+    }
+    return true;
+}
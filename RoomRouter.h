@@ -0,0 +1,101 @@
+// File: RoomRouter.h
+
+#ifndef ZOORK_ROOMROUTER_H
+#define ZOORK_ROOMROUTER_H
+
+#include "BKTree.h"
+#include "RoomGraph.h"
+#include "Symbol.h"
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <string_view>
+#include <vector>
+
+//
+//  Shortest routes (fewest passages) over a RoomGraph, for "travel".
+//
+//  Worlds of up to TABLE_LIMIT rooms get an all-pairs next-hop table: a
+//  route is then a walk down the table.  Larger worlds are searched per
+//  request with a bidirectional breadth-first search over the passages and
+//  their reverse, which meets in the middle and so visits far fewer rooms
+//  than a one-sided search.  Passages carry no distances or coordinates,
+//  so there is nothing for A* to work with.
+//
+//  Also finds rooms by name, case-insensitively: by the whole name, by a
+//  prefix of it (room ids kept sorted by lowercased name), or by near
+//  misses for suggestions (a BKTree of the lowercased names, built once,
+//  the first time one is asked for).
+//
+//  The table, the reverse passages and the name order are built with the
+//  router, along with its RoomGraph.  One router serves every session of a
+//  world, on any thread: queries are const, and each caller brings its own
+//  Scratch for the working state of a search.
+//
+class RoomRouter {
+public:
+    static constexpr std::size_t TABLE_LIMIT = 1024;
+
+    // Working state of route searches and suggestions; keep one per session
+    // and reuse it
+    struct Scratch {
+        // A room counts as seen by a side only if its mark is the current
+        // search's
+        std::vector<std::uint32_t> forwardMark;
+        std::vector<std::uint32_t> backwardMark;
+        std::vector<RoomId> forwardParent;    // the room it was reached from
+        std::vector<RoomId> backwardParent;   // the room it leads on to
+        std::vector<RoomId> frontier;
+        std::vector<RoomId> backFrontier;
+        std::vector<RoomId> nextFrontier;
+        std::uint32_t search = 0;
+
+        BKTree::Scratch near;
+        std::vector<Symbol> nearNames;
+    };
+
+    explicit RoomRouter(const RoomGraph &graph);
+
+    // Id of the room whose lowercased name is `lowerName`, or NO_ROOM
+    RoomId findRoom(Symbol lowerName) const;
+
+    // Rooms whose lowercased name starts with `lowerPrefix`, in name order
+    std::span<const RoomId> findRoomsByPrefix(std::string_view lowerPrefix) const;
+
+    // Rooms whose lowercased name is within `limit` edits of `lowerName`,
+    // closest first
+    void suggestRooms(std::string_view lowerName, std::size_t limit, std::vector<RoomId> &rooms,
+                      Scratch &scratch) const;
+
+    // Rooms passed through from `from` to `to`, ending with `to` (empty if
+    // they are the same room); none but `to` is gated. False if `to`
+    // cannot be reached.
+    bool findRoute(RoomId from, RoomId to, std::vector<RoomId> &route, Scratch &scratch) const;
+
+private:
+    // A moved RoomGraph takes its router along and points it at itself
+    friend class RoomGraph;
+
+    void buildNextHops();
+    void buildReverseEdges();
+    bool searchBothWays(RoomId from, RoomId to, std::vector<RoomId> &route, Scratch &scratch) const;
+
+    const RoomGraph *graph;
+
+    // Every room, by lowercased name
+    std::vector<RoomId> byName;
+
+    // Built by the first suggestRooms(), whichever thread calls it
+    mutable std::once_flag nearNamesBuilt;
+    mutable BKTree nearNames;
+
+    // Small worlds: nextHops[from * rooms + to], NO_HOP if unreachable
+    static constexpr std::uint16_t NO_HOP = 0xffff;
+    std::vector<std::uint16_t> nextHops;
+
+    // Large worlds: incoming passages, in CSR form like the graph
+    std::vector<std::uint32_t> reverseOffsets;
+    std::vector<RoomId> reverseSources;
+};
+
+#endif // ZOORK_ROOMROUTER_H
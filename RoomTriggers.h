@@ -0,0 +1,40 @@
+// File: RoomTriggers.h
+
+#ifndef ZOORK_ROOMTRIGGERS_H
+#define ZOORK_ROOMTRIGGERS_H
+
+#include "EnemyTypes.h"
+#include "WorldImage.h"
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// A first-arrival fight and what it leaves behind; the text is a view into
+// the world's image
+struct Encounter {
+    std::string_view intro;
+    EnemyType foe;
+    std::string_view deathMessage;
+    std::string_view victoryMessage;
+    std::string_view lootName;
+    std::string_view lootLook;
+    std::string_view lootSearch;
+};
+
+//
+//  A world's encounters are written next to their rooms in its source and
+//  numbered in its image (see WorldImage::EncounterRecord).  When the world
+//  is loaded each is bound to its room (Room::setTrigger), so entering a
+//  room costs one indexed lookup however many there are, and whether each
+//  has fired yet is one bit of a session's Fired set.
+//
+struct RoomTriggers {
+    static constexpr std::uint16_t NONE = 0xffff;
+    static constexpr std::size_t MAX = WorldImage::MAX_ENCOUNTERS;
+
+    // Bit i set once trigger i has fired in a game
+    using Fired = std::bitset<MAX>;
+};
+
+#endif // ZOORK_ROOMTRIGGERS_H
@@ -0,0 +1,15 @@
+// File: SessionContext.cpp
+
+#include "SessionContext.h"
+
+SessionContext::SessionContext() : seed(std::random_device{}()), rng(seed) {}
+
+SessionContext::SessionContext(std::uint32_t s) : seed(s), rng(seed) {}
+
+void SessionContext::reset() {
+    player.reset();
+    overlay.clear();
+    seed = std::random_device{}();
+    rng.seed(seed);
+    output.clear();
+}
@@ -0,0 +1,49 @@
+// File: SessionContext.h
+
+#ifndef ZOORK_SESSIONCONTEXT_H
+#define ZOORK_SESSIONCONTEXT_H
+
+#include "OutputSink.h"
+#include "Player.h"
+#include "WorldOverlay.h"
+#include <cstdint>
+#include <random>
+
+//
+//  Everything one game session may mutate: the Player, its changes to the
+//  shared world, the random number generator used by combat, and the sink
+//  all of the session's game text is printed to.  Each ZOOrkEngine is handed
+//  its own context, so engines share no mutable state and can run on
+//  separate threads.
+//
+class SessionContext {
+public:
+    // Seeded from std::random_device
+    SessionContext();
+    // Fixed seed, for reproducible runs
+    explicit SessionContext(std::uint32_t seed);
+
+    SessionContext(const SessionContext &) = delete;
+    SessionContext &operator=(const SessionContext &) = delete;
+
+    // Start over for a new game: fresh Player, untouched world, new seed,
+    // no pending output
+    void reset();
+
+    Player &getPlayer() { return player; }
+    WorldOverlay &getOverlay() { return overlay; }
+    std::mt19937 &getRng() { return rng; }
+    OutputSink &getOutput() { return output; }
+
+    // What the RNG was last seeded with (by construction or reset())
+    std::uint32_t getSeed() const { return seed; }
+
+private:
+    Player player;
+    WorldOverlay overlay;
+    std::uint32_t seed;
+    std::mt19937 rng;
+    OutputSink output;
+};
+
+#endif // ZOORK_SESSIONCONTEXT_H
@@ -0,0 +1,35 @@
+// File: SessionPool.cpp
+
+#include "SessionPool.h"
+#include <utility>
+
+GameSession::GameSession(std::shared_ptr<const WorldManager> w)
+    : world(std::move(w)), engine(world->getStartingRoom(), context) {
+    engine.setRoomMap(world->getAllRooms());
+}
+
+void GameSession::reset() {
+    context.reset();
+    engine.reset(world->getStartingRoom());
+}
+
+std::unique_ptr<GameSession> SessionPool::acquire() {
+    if (idle.empty()) {
+        return std::make_unique<GameSession>(world);
+    }
+    std::unique_ptr<GameSession> game = std::move(idle.back());
+    idle.pop_back();
+    return game;
+}
+
+void SessionPool::release(std::unique_ptr<GameSession> game) {
+    if (!game || idle.size() >= maxIdle) return;
+    game->reset();
+    idle.push_back(std::move(game));
+}
+
+void SessionPool::prewarm(std::size_t count) {
+    while (idle.size() < maxIdle && count-- > 0) {
+        idle.push_back(std::make_unique<GameSession>(world));
+    }
+}
@@ -0,0 +1,62 @@
+// File: SessionPool.h
+
+#ifndef ZOORK_SESSIONPOOL_H
+#define ZOORK_SESSIONPOOL_H
+
+#include "SessionContext.h"
+#include "WorldManager.h"
+#include "ZOOrkEngine.h"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+//
+//  Everything one game needs, built once and reusable: the session's context
+//  (Player, world overlay, RNG, output) and an engine wired to it, playing in
+//  a shared read-only world.
+//
+struct GameSession {
+    explicit GameSession(std::shared_ptr<const WorldManager> world);
+
+    GameSession(const GameSession &) = delete;
+    GameSession &operator=(const GameSession &) = delete;
+
+    // Back to the state of a freshly built GameSession
+    void reset();
+
+    std::shared_ptr<const WorldManager> world;
+    SessionContext context;
+    ZOOrkEngine engine;
+};
+
+//
+//  Hands out games that all play in one shared world, and keeps finished
+//  ones around instead of freeing them: a new session then costs a reset of
+//  its context rather than a fresh Player, engine and verb tables.
+//
+class SessionPool {
+public:
+    explicit SessionPool(std::shared_ptr<const WorldManager> world, std::size_t maxIdle = 256)
+        : world(std::move(world)), maxIdle(maxIdle) {}
+
+    // A ready-to-play game: recycled if one is idle, otherwise built
+    std::unique_ptr<GameSession> acquire();
+
+    // Hand a game back once nothing refers to it any more (its play()
+    // coroutine has been destroyed). It is reset and kept if there is room.
+    void release(std::unique_ptr<GameSession> game);
+
+    // Build games ahead of time, up to the idle limit
+    void prewarm(std::size_t count);
+
+    std::size_t idleCount() const { return idle.size(); }
+
+    const std::shared_ptr<const WorldManager> &getWorld() const { return world; }
+
+private:
+    std::shared_ptr<const WorldManager> world;
+    std::size_t maxIdle;
+    std::vector<std::unique_ptr<GameSession>> idle;
+};
+
+#endif // ZOORK_SESSIONPOOL_H
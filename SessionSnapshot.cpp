@@ -0,0 +1,302 @@
+// File: SessionSnapshot.cpp
+
+#include "SessionSnapshot.h"
+#include "Item.h"
+#include "ItemRegistry.h"
+#include "RoomTriggers.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <optional>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <type_traits>
+#include <unistd.h>
+
+namespace {
+
+constexpr char MAGIC[4] = {'Z', 'K', 'S', 'S'};
+constexpr std::uint32_t NO_ROOM = 0xffffffffu;
+
+constexpr std::size_t FIRED_WORDS = RoomTriggers::MAX / 64;
+
+struct Header {
+    char magic[4];
+    std::uint16_t version;
+    std::uint16_t headerSize;
+    std::uint32_t rngSize;
+    std::uint32_t itemCount;
+    std::uint64_t totalSize;
+    std::uint64_t worldFingerprint;
+    std::uint64_t firedTriggers[FIRED_WORDS];  // bit i of word i / 64: trigger i
+    std::uint32_t worldRooms;
+    std::uint32_t currentRoom;       // NO_ROOM if the player is nowhere
+    std::int32_t health[4];          // head, thorax, arms, legs
+    std::uint32_t overlayCount;      // string pool runs from the records to totalSize
+    std::uint32_t reserved;
+};
+
+struct ItemRecord {
+    std::uint8_t itemType;
+    std::uint8_t weaponType;
+    std::uint8_t equipped;
+    std::uint8_t weaponFlags;        // 1 = reloading, 2 = scoped
+    std::int32_t value;              // ammo, armor bonus or heal amount
+    std::uint32_t nameOffset;
+    std::uint32_t nameLength;
+    std::uint32_t descOffset;
+    std::uint32_t descLength;
+};
+
+struct OverlayRecord {
+    std::uint32_t room;
+    std::uint32_t kind;
+    std::uint32_t nameOffset;
+    std::uint32_t nameLength;
+    std::uint32_t textOffset;
+    std::uint32_t textLength;
+};
+
+static_assert(RoomTriggers::MAX % 64 == 0);
+static_assert(sizeof(Header) == 64 + 8 * FIRED_WORDS);
+static_assert(sizeof(ItemRecord) == 24);
+static_assert(sizeof(OverlayRecord) == 24);
+static_assert(std::is_trivially_copyable_v<Header>);
+static_assert(std::is_trivially_copyable_v<ItemRecord>);
+static_assert(std::is_trivially_copyable_v<OverlayRecord>);
+static_assert(std::is_trivially_copyable_v<std::mt19937>);
+
+constexpr std::size_t RNG_BYTES = (sizeof(std::mt19937) + 7) & ~std::size_t{7};
+
+std::uint32_t addString(std::string &pool, std::string_view s) {
+    auto offset = static_cast<std::uint32_t>(pool.size());
+    pool.append(s);
+    return offset;
+}
+
+template <typename T>
+void appendRaw(std::string &image, const T &value) {
+    image.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+// The item a record describes, if its name is an item of the recorded kind
+// in `items`; the text it was saved with comes from the registry now
+std::optional<Item> buildItem(const ItemRecord &rec, std::string_view strings, const ItemRegistry &items) {
+    std::uint16_t prototype = items.findPrototypeByName(Symbol::lookup(strings.substr(rec.nameOffset, rec.nameLength)));
+    if (prototype == ItemRegistry::NONE) return std::nullopt;
+
+    Item item(prototype);
+    if (static_cast<std::uint8_t>(item.getItemType()) != rec.itemType) return std::nullopt;
+    if (item.getItemType() == ItemType::Weapon) {
+        if (rec.weaponType != static_cast<std::uint8_t>(item.getWeaponType())) return std::nullopt;
+        Weapon weapon(item.getWeaponType());
+        weapon.restoreState(rec.value, (rec.weaponFlags & 1) != 0, (rec.weaponFlags & 2) != 0);
+        item.keepWeaponState(weapon);
+    }
+    return item;
+}
+
+} // namespace
+
+std::string SessionSnapshot::save(const WorldManager &world, const ZOOrkEngine &engine, SessionContext &context) {
+    if (engine.isGameOver() || !engine.isAtCommandPrompt()) return {};
+
+    const Player &player = context.getPlayer();
+    auto items = player.getInventory().getItems();
+    const auto &entries = context.getOverlay().getEntries();
+
+    std::string strings;
+    std::vector<ItemRecord> itemRecords;
+    itemRecords.reserve(items.size());
+    for (const auto &item : items) {
+        ItemRecord rec{};
+        rec.itemType = static_cast<std::uint8_t>(item.getItemType());
+        rec.equipped = item.isEquipped() ? 1 : 0;
+        if (item.getItemType() == ItemType::Weapon) {
+            rec.weaponType = static_cast<std::uint8_t>(item.getWeaponType());
+            rec.weaponFlags = static_cast<std::uint8_t>((item.isReloading() ? 1 : 0) | (item.isScoped() ? 2 : 0));
+            rec.value = item.getAmmo();
+        } else if (item.getItemType() == ItemType::Armor) {
+            rec.value = item.getArmorBonus();
+        } else if (item.getItemType() == ItemType::Medkit) {
+            rec.value = item.getHealAmount();
+        }
+        rec.nameLength = static_cast<std::uint32_t>(item.getName().size());
+        rec.nameOffset = addString(strings, item.getName());
+        rec.descLength = static_cast<std::uint32_t>(item.getDescription().size());
+        rec.descOffset = addString(strings, item.getDescription());
+        itemRecords.push_back(rec);
+    }
+
+    std::vector<OverlayRecord> overlayRecords;
+    overlayRecords.reserve(entries.size());
+    for (const auto &e : entries) {
+        OverlayRecord rec{};
+        rec.room = e.room;
+        rec.kind = static_cast<std::uint32_t>(e.kind);
+        rec.nameLength = static_cast<std::uint32_t>(e.name.size());
+        rec.nameOffset = addString(strings, e.name);
+        rec.textLength = static_cast<std::uint32_t>(e.text.size());
+        rec.textOffset = addString(strings, e.text);
+        overlayRecords.push_back(rec);
+    }
+
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.headerSize = sizeof(Header);
+    header.rngSize = sizeof(std::mt19937);
+    header.worldFingerprint = world.getFingerprint();
+    header.worldRooms = static_cast<std::uint32_t>(world.getRoomCount());
+    Room *room = player.getCurrentRoom();
+    header.currentRoom = room ? room->getId() : NO_ROOM;
+    header.health[0] = player.headHealth;
+    header.health[1] = player.thoraxHealth;
+    header.health[2] = player.armsHealth;
+    header.health[3] = player.legsHealth;
+    const RoomTriggers::Fired &fired = engine.getFiredTriggers();
+    for (std::size_t i = 0; i < RoomTriggers::MAX; ++i) {
+        if (fired.test(i)) header.firedTriggers[i / 64] |= std::uint64_t{1} << (i % 64);
+    }
+    header.itemCount = static_cast<std::uint32_t>(itemRecords.size());
+    header.overlayCount = static_cast<std::uint32_t>(overlayRecords.size());
+    header.totalSize = sizeof(Header) + RNG_BYTES
+                     + itemRecords.size() * sizeof(ItemRecord)
+                     + overlayRecords.size() * sizeof(OverlayRecord)
+                     + strings.size();
+
+    std::string image;
+    image.reserve(header.totalSize);
+    appendRaw(image, header);
+    appendRaw(image, context.getRng());
+    image.resize(sizeof(Header) + RNG_BYTES, '\0');
+    image.append(reinterpret_cast<const char *>(itemRecords.data()), itemRecords.size() * sizeof(ItemRecord));
+    image.append(reinterpret_cast<const char *>(overlayRecords.data()), overlayRecords.size() * sizeof(OverlayRecord));
+    image.append(strings);
+    return image;
+}
+
+bool SessionSnapshot::restore(std::string_view image, const WorldManager &world,
+                              ZOOrkEngine &engine, SessionContext &context) {
+    context.reset();
+
+    Header header;
+    if (image.size() < sizeof(Header)) return false;
+    std::memcpy(&header, image.data(), sizeof(Header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0
+        || header.version != VERSION
+        || header.headerSize != sizeof(Header)
+        || header.rngSize != sizeof(std::mt19937)
+        || header.worldFingerprint != world.getFingerprint()
+        || header.worldRooms != world.getRoomCount()) {
+        return false;
+    }
+
+    const std::size_t itemsAt = sizeof(Header) + RNG_BYTES;
+    const std::size_t overlayAt = itemsAt + std::size_t{header.itemCount} * sizeof(ItemRecord);
+    const std::size_t stringsAt = overlayAt + std::size_t{header.overlayCount} * sizeof(OverlayRecord);
+    if (header.totalSize != image.size() || stringsAt > image.size()) return false;
+
+    Room *room = nullptr;
+    if (header.currentRoom != NO_ROOM) {
+        room = world.getRoomById(header.currentRoom);
+        if (!room) return false;
+    }
+
+    std::string_view strings = image.substr(stringsAt);
+    auto inPool = [&](std::uint32_t offset, std::uint32_t length) {
+        return offset <= strings.size() && length <= strings.size() - offset;
+    };
+
+    Player &player = context.getPlayer();
+    Inventory &inventory = player.getInventory();
+    for (std::uint32_t i = 0; i < header.itemCount; ++i) {
+        ItemRecord rec;
+        std::memcpy(&rec, image.data() + itemsAt + i * sizeof(ItemRecord), sizeof(ItemRecord));
+        if (!inPool(rec.nameOffset, rec.nameLength) || !inPool(rec.descOffset, rec.descLength)) {
+            context.reset();
+            return false;
+        }
+        auto item = buildItem(rec, strings, world.getItems());
+        if (!item || !inventory.restoreItem(*item, rec.equipped != 0)) {
+            context.reset();
+            return false;
+        }
+    }
+
+    WorldOverlay &overlay = context.getOverlay();
+    for (std::uint32_t i = 0; i < header.overlayCount; ++i) {
+        OverlayRecord rec;
+        std::memcpy(&rec, image.data() + overlayAt + i * sizeof(OverlayRecord), sizeof(OverlayRecord));
+        if (rec.room >= header.worldRooms || rec.kind > static_cast<std::uint32_t>(WorldOverlay::Kind::Search)
+            || !inPool(rec.nameOffset, rec.nameLength) || !inPool(rec.textOffset, rec.textLength)) {
+            context.reset();
+            return false;
+        }
+        overlay.set(rec.room, static_cast<WorldOverlay::Kind>(rec.kind),
+                    strings.substr(rec.nameOffset, rec.nameLength),
+                    strings.substr(rec.textOffset, rec.textLength));
+    }
+
+    std::memcpy(static_cast<void *>(&context.getRng()), image.data() + sizeof(Header), sizeof(std::mt19937));
+    player.headHealth = header.health[0];
+    player.thoraxHealth = header.health[1];
+    player.armsHealth = header.health[2];
+    player.legsHealth = header.health[3];
+    engine.reset(nullptr);
+    player.setCurrentRoom(room);
+    RoomTriggers::Fired fired;
+    for (std::size_t i = 0; i < RoomTriggers::MAX; ++i) {
+        fired.set(i, (header.firedTriggers[i / 64] >> (i % 64)) & 1);
+    }
+    engine.setFiredTriggers(fired);
+    return true;
+}
+
+bool SessionSnapshot::saveFile(const std::string &path, const WorldManager &world,
+                               const ZOOrkEngine &engine, SessionContext &context) {
+    std::string image = save(world, engine, context);
+    if (image.empty()) return false;
+
+    std::string tmpPath = path + ".tmp";
+    int fd = ::open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) return false;
+
+    const char *data = image.data();
+    std::size_t left = image.size();
+    bool ok = true;
+    while (left > 0) {
+        ssize_t n = ::write(fd, data, left);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            ok = false;
+            break;
+        }
+        data += n;
+        left -= static_cast<std::size_t>(n);
+    }
+    if (::close(fd) != 0) ok = false;
+    if (ok && ::rename(tmpPath.c_str(), path.c_str()) != 0) ok = false;
+    if (!ok) ::unlink(tmpPath.c_str());
+    return ok;
+}
+
+bool SessionSnapshot::restoreFile(const std::string &path, const WorldManager &world,
+                                  ZOOrkEngine &engine, SessionContext &context) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(Header))) {
+        ::close(fd);
+        return false;
+    }
+    auto size = static_cast<std::size_t>(st.st_size);
+    void *mapped = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) return false;
+
+    bool ok = restore(std::string_view(static_cast<const char *>(mapped), size), world, engine, context);
+    ::munmap(mapped, size);
+    return ok;
+}
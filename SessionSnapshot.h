@@ -0,0 +1,56 @@
+// File: SessionSnapshot.h
+
+#ifndef ZOORK_SESSIONSNAPSHOT_H
+#define ZOORK_SESSIONSNAPSHOT_H
+
+#include "SessionContext.h"
+#include "WorldManager.h"
+#include "ZOOrkEngine.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+//
+//  Versioned binary image of one game, taken at the command prompt: the
+//  player's room, health and inventory (weapon state included), the
+//  session's world overlay, which room triggers have fired and the exact
+//  RNG state, so a restored fight rolls the same dice.
+//
+//  Layout (native byte order, every section 8-byte aligned):
+//
+//      Header          80 bytes, magic "ZKSS", format version, sizes
+//      RNG state       the std::mt19937 object as-is
+//      ItemRecord[]    24 bytes each
+//      OverlayRecord[] 24 bytes each
+//      string pool     names and texts, referenced by offset/length
+//
+//  Fixed-size records are copied straight out of the image; the only
+//  per-item work on restore is rebuilding the Item objects themselves.
+//  A snapshot only restores into a world with the same room list (checked
+//  by fingerprint) and a build with the same RNG layout.  Pending output
+//  is not part of it: flush the session's OutputSink before saving.
+//
+struct SessionSnapshot {
+    static constexpr std::uint16_t VERSION = 2;
+
+    // Image of the game, or an empty string if it cannot be saved right now
+    // (game over, or not waiting at the command prompt)
+    static std::string save(const WorldManager &world, const ZOOrkEngine &engine, SessionContext &context);
+
+    // Put a saved game back into `context` and `engine`. The context is
+    // reset first; returns false (and leaves it reset) if `image` is not a
+    // valid snapshot for this world. Continue with engine.resume(...).
+    static bool restore(std::string_view image, const WorldManager &world,
+                        ZOOrkEngine &engine, SessionContext &context);
+
+    // save() to `path` with a single write(), via a temporary file renamed
+    // over `path` so a crash never leaves half a snapshot behind
+    static bool saveFile(const std::string &path, const WorldManager &world,
+                         const ZOOrkEngine &engine, SessionContext &context);
+
+    // restore() from a file mapped read-only into memory
+    static bool restoreFile(const std::string &path, const WorldManager &world,
+                            ZOOrkEngine &engine, SessionContext &context);
+};
+
+#endif // ZOORK_SESSIONSNAPSHOT_H
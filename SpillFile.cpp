@@ -0,0 +1,122 @@
+// File: SpillFile.cpp
+
+#include "SpillFile.h"
+#include <cerrno>
+#include <cstdlib>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+// Dead space tolerated before a rewrite
+constexpr std::uint64_t MIN_RECLAIM_BYTES = 1 << 20;
+
+bool writeAll(int fd, const char *data, std::size_t length, std::uint64_t offset) {
+    while (length > 0) {
+        ssize_t n = ::pwrite(fd, data, length, static_cast<off_t>(offset));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += n;
+        length -= static_cast<std::size_t>(n);
+        offset += static_cast<std::uint64_t>(n);
+    }
+    return true;
+}
+
+bool readAll(int fd, char *data, std::size_t length, std::uint64_t offset) {
+    while (length > 0) {
+        ssize_t n = ::pread(fd, data, length, static_cast<off_t>(offset));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        data += n;
+        length -= static_cast<std::size_t>(n);
+        offset += static_cast<std::uint64_t>(n);
+    }
+    return true;
+}
+
+} // namespace
+
+SpillFile::~SpillFile() {
+    if (fd >= 0) ::close(fd);
+}
+
+int SpillFile::createFile(const std::string &directory) {
+    std::string path = directory + "/zoork-spill-XXXXXX";
+    int f = ::mkstemp(path.data());
+    if (f < 0) return -1;
+    ::unlink(path.c_str());
+    return f;
+}
+
+bool SpillFile::open(const std::string &directory) {
+    int f = createFile(directory);
+    if (f < 0) return false;
+    if (fd >= 0) ::close(fd);
+    dir = directory;
+    fd = f;
+    extents.clear();
+    end = live = 0;
+    return true;
+}
+
+bool SpillFile::put(std::uint64_t key, std::string_view blob) {
+    if (fd < 0) return false;
+    drop(key);
+    if (!writeAll(fd, blob.data(), blob.size(), end)) return false;
+    extents[key] = Extent{end, static_cast<std::uint32_t>(blob.size())};
+    end += blob.size();
+    live += blob.size();
+    return true;
+}
+
+bool SpillFile::take(std::uint64_t key, std::string &blob) {
+    auto it = extents.find(key);
+    if (it == extents.end()) return false;
+    blob.resize(it->second.length);
+    bool ok = readAll(fd, blob.data(), blob.size(), it->second.offset);
+    drop(key);
+    return ok;
+}
+
+void SpillFile::drop(std::uint64_t key) {
+    auto it = extents.find(key);
+    if (it == extents.end()) return;
+    live -= it->second.length;
+    extents.erase(it);
+    reclaim();
+}
+
+void SpillFile::reclaim() {
+    if (extents.empty()) {
+        if (end > 0 && ::ftruncate(fd, 0) == 0) end = 0;
+        return;
+    }
+    std::uint64_t dead = end - live;
+    if (dead < MIN_RECLAIM_BYTES || dead < live) return;
+
+    // Copy the live blobs, packed, into a new file and switch to it
+    int f = createFile(dir);
+    if (f < 0) return;
+    std::vector<char> buffer;
+    std::uint64_t at = 0;
+    for (auto &kv : extents) {
+        buffer.resize(kv.second.length);
+        if (!readAll(fd, buffer.data(), buffer.size(), kv.second.offset)
+            || !writeAll(f, buffer.data(), buffer.size(), at)) {
+            ::close(f);
+            return;   // keep using the old file; try again later
+        }
+        at += kv.second.length;
+    }
+    at = 0;
+    for (auto &kv : extents) {
+        kv.second.offset = at;
+        at += kv.second.length;
+    }
+    ::close(fd);
+    fd = f;
+    end = at;
+}
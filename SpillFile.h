@@ -0,0 +1,60 @@
+// File: SpillFile.h
+
+#ifndef ZOORK_SPILLFILE_H
+#define ZOORK_SPILLFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+//
+//  Scratch file for blobs parked out of memory (hibernated sessions), keyed
+//  by an integer.  The file is unlinked as soon as it is created, so it
+//  disappears with the process.  Blobs are appended; space freed by take()
+//  or drop() is reclaimed by rewriting the live blobs into a fresh file once
+//  more than half of it is dead, and all at once whenever it empties.
+//
+class SpillFile {
+public:
+    SpillFile() = default;
+    ~SpillFile();
+
+    SpillFile(const SpillFile &) = delete;
+    SpillFile &operator=(const SpillFile &) = delete;
+
+    // Create the scratch file in `directory`. Returns false on failure.
+    bool open(const std::string &directory);
+    bool isOpen() const { return fd >= 0; }
+
+    // Park `blob` under `key` (replacing any blob already there)
+    bool put(std::uint64_t key, std::string_view blob);
+
+    // Read back the blob parked under `key` and forget it
+    bool take(std::uint64_t key, std::string &blob);
+
+    // Forget the blob under `key`, if any
+    void drop(std::uint64_t key);
+
+    std::size_t count() const { return extents.size(); }
+    std::uint64_t liveBytes() const { return live; }
+    std::uint64_t fileBytes() const { return end; }
+
+private:
+    struct Extent {
+        std::uint64_t offset;
+        std::uint32_t length;
+    };
+
+    static int createFile(const std::string &directory);
+    void reclaim();
+
+    std::string dir;
+    int fd = -1;
+    std::unordered_map<std::uint64_t, Extent> extents;
+    std::uint64_t end = 0;    // bytes used in the file
+    std::uint64_t live = 0;   // bytes still referenced
+};
+
+#endif // ZOORK_SPILLFILE_H
@@ -0,0 +1,136 @@
+// File: Symbol.cpp
+
+#include "Symbol.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cctype>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+class SymbolTable {
+public:
+    SymbolTable() { add(std::string_view(), 0); }
+
+    std::uint32_t intern(std::string_view text) {
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            auto it = index.find(text);
+            if (it != index.end()) return it->second;
+        }
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        return internLocked(text);
+    }
+
+    std::uint32_t lookup(std::string_view text) const {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        auto it = index.find(text);
+        return it != index.end() ? it->second : NOT_FOUND;
+    }
+
+    std::string_view text(std::uint32_t id) const { return id < count.load(std::memory_order_acquire) ? entry(id).text : std::string_view(); }
+    std::uint32_t lower(std::uint32_t id) const { return id < count.load(std::memory_order_acquire) ? entry(id).lower : id; }
+
+    static constexpr std::uint32_t NOT_FOUND = 0xffffffffu;
+
+private:
+    static constexpr std::size_t BLOCK_SIZE = 64 * 1024;
+
+    // Entries live in segments of FIRST_SEGMENT, 2 * FIRST_SEGMENT, ...
+    // entries that never move, so text() reads them without the lock
+    static constexpr std::uint64_t FIRST_SEGMENT = 1024;
+    static constexpr std::size_t SEGMENTS = 24;   // more than 2^32 entries
+
+    struct Entry {
+        std::string_view text;
+        std::uint32_t lower;
+    };
+
+    static std::size_t segmentOf(std::uint64_t id) { return std::bit_width(id / FIRST_SEGMENT + 1) - 1; }
+    static std::uint64_t segmentStart(std::size_t s) { return FIRST_SEGMENT * ((std::uint64_t{1} << s) - 1); }
+
+    const Entry &entry(std::uint32_t id) const {
+        std::size_t s = segmentOf(id);
+        return segments[s][id - segmentStart(s)];
+    }
+
+    std::uint32_t internLocked(std::string_view text) {
+        auto it = index.find(text);
+        if (it != index.end()) return it->second;
+
+        // The lowercase form first, so this entry can point at it
+        std::string lowered(text);
+        for (char &c : lowered) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        if (lowered == text) return add(store(text), count.load(std::memory_order_relaxed));
+        std::uint32_t lower = internLocked(lowered);
+        return add(store(text), lower);
+    }
+
+    // Write the entry, then publish it by bumping `count`
+    std::uint32_t add(std::string_view text, std::uint32_t lower) {
+        std::uint32_t id = count.load(std::memory_order_relaxed);
+        std::size_t s = segmentOf(id);
+        if (!segments[s]) segments[s] = std::make_unique<Entry[]>(FIRST_SEGMENT << s);
+        segments[s][id - segmentStart(s)] = Entry{text, lower};
+        index.emplace(text, id);
+        count.store(id + 1, std::memory_order_release);
+        return id;
+    }
+
+    // Copy into the current block, or a block of its own if it is large;
+    // blocks are never resized, so the copies never move
+    std::string_view store(std::string_view text) {
+        if (text.size() > BLOCK_SIZE / 4) {
+            largeTexts.push_back(std::make_unique<char[]>(text.size()));
+            std::copy(text.begin(), text.end(), largeTexts.back().get());
+            return {largeTexts.back().get(), text.size()};
+        }
+        if (blocks.empty() || blockUsed + text.size() > BLOCK_SIZE) {
+            blocks.push_back(std::make_unique<char[]>(BLOCK_SIZE));
+            blockUsed = 0;
+        }
+        char *at = blocks.back().get() + blockUsed;
+        std::copy(text.begin(), text.end(), at);
+        blockUsed += text.size();
+        return {at, text.size()};
+    }
+
+    // Guards everything but the published entries
+    mutable std::shared_mutex mutex;
+    std::array<std::unique_ptr<Entry[]>, SEGMENTS> segments;
+    std::atomic<std::uint32_t> count{0};
+    std::unordered_map<std::string_view, std::uint32_t> index;
+    std::vector<std::unique_ptr<char[]>> blocks;
+    std::vector<std::unique_ptr<char[]>> largeTexts;
+    std::size_t blockUsed = 0;
+};
+
+SymbolTable &table() {
+    static SymbolTable instance;
+    return instance;
+}
+
+} // namespace
+
+Symbol Symbol::intern(std::string_view text) {
+    return Symbol(table().intern(text));
+}
+
+Symbol Symbol::lookup(std::string_view text) {
+    return Symbol(table().lookup(text));
+}
+
+std::string_view Symbol::text() const {
+    return table().text(value);
+}
+
+Symbol Symbol::lower() const {
+    return Symbol(table().lower(value));
+}
@@ -0,0 +1,55 @@
+// File: Symbol.h
+
+#ifndef ZOORK_SYMBOL_H
+#define ZOORK_SYMBOL_H
+
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+//
+//  An interned name: a 32-bit handle into one process-wide table that
+//  keeps each distinct text exactly once.  Two symbols are equal exactly
+//  when their texts are, so names compare, hash and copy as integers.
+//
+//  Interning a name also interns its lowercase form, reachable with
+//  lower(), so player input (which CommandLine has already lowercased) is
+//  matched against a name case-insensitively with one table lookup and an
+//  integer compare.
+//
+//  Texts are never freed and never move: text() views stay valid for the
+//  life of the process.  Every member is safe to call from any thread:
+//  interning and lookup lock the table, text() and lower() do not.
+//
+class Symbol {
+public:
+    // The empty name
+    constexpr Symbol() = default;
+
+    // Symbol for `text`, adding it (and its lowercase form) if new
+    static Symbol intern(std::string_view text);
+
+    // Symbol for `text` if it has been interned, else none(): a symbol
+    // equal to no name, for input that cannot match anything
+    static Symbol lookup(std::string_view text);
+    static constexpr Symbol none() { return Symbol(NONE_ID); }
+
+    std::string_view text() const;
+    Symbol lower() const;
+
+    std::uint32_t id() const { return value; }
+    bool operator==(const Symbol &) const = default;
+
+private:
+    static constexpr std::uint32_t NONE_ID = 0xffffffffu;
+    constexpr explicit Symbol(std::uint32_t id) : value(id) {}
+
+    std::uint32_t value = 0;
+};
+
+template <>
+struct std::hash<Symbol> {
+    std::size_t operator()(Symbol s) const noexcept { return s.id(); }
+};
+
+#endif // ZOORK_SYMBOL_H
@@ -0,0 +1,86 @@
+// File: Task.h
+
+#ifndef ZOORK_TASK_H
+#define ZOORK_TASK_H
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+//
+//  Task: the coroutine type the engine and combat loops are written as.
+//
+//  A Task does nothing until it is started or awaited.  `co_await task`
+//  runs it inside the awaiting coroutine and continues there when it
+//  finishes, so a handler can co_await a whole fight the way it used to
+//  call a blocking function.  Whenever the innermost coroutine suspends
+//  (it is waiting for input), control returns to whoever called start()
+//  or resumed it; the whole chain is picked up again from the point it
+//  stopped once that input arrives.
+//
+class Task {
+public:
+    struct promise_type;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    // When a Task finishes, carry on with the coroutine that awaited it
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+        std::coroutine_handle<> await_suspend(Handle finished) noexcept {
+            return finished.promise().continuation;
+        }
+        void await_resume() const noexcept {}
+    };
+
+    struct promise_type {
+        std::coroutine_handle<> continuation = std::noop_coroutine();
+
+        Task get_return_object() { return Task(Handle::from_promise(*this)); }
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        FinalAwaiter final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        // The game does not use exceptions; one escaping a coroutine is a bug
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+
+    struct Awaiter {
+        Handle task;
+
+        bool await_ready() const noexcept { return task.done(); }
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+            task.promise().continuation = awaiting;
+            return task;
+        }
+        void await_resume() const noexcept {}
+    };
+
+    Task() = default;
+    Task(Task &&other) noexcept : handle(std::exchange(other.handle, {})) {}
+    Task &operator=(Task &&other) noexcept {
+        if (this != &other) {
+            if (handle) handle.destroy();
+            handle = std::exchange(other.handle, {});
+        }
+        return *this;
+    }
+    ~Task() {
+        if (handle) handle.destroy();
+    }
+
+    Task(const Task &) = delete;
+    Task &operator=(const Task &) = delete;
+
+    // Run a top-level task until it first waits for input (or finishes)
+    void start() { handle.resume(); }
+
+    bool done() const { return !handle || handle.done(); }
+
+    Awaiter operator co_await() && noexcept { return Awaiter{handle}; }
+
+private:
+    explicit Task(Handle h) : handle(h) {}
+
+    Handle handle;
+};
+
+#endif // ZOORK_TASK_H
@@ -0,0 +1,112 @@
+// File: VerbTable.h
+
+#ifndef ZOORK_VERBTABLE_H
+#define ZOORK_VERBTABLE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+//
+//  Every command the engine knows how to run.  The numeric value doubles as
+//  the index into ZOOrkEngine's flat handler table.
+//
+enum class VerbId : std::uint8_t {
+    Go,
+    Travel,
+    Look,
+    Search,
+    Take,
+    Drop,
+    Inventory,
+    Help,
+    Quit,
+    Count
+};
+
+struct VerbEntry {
+    std::string_view word;
+    VerbId id;
+};
+
+//
+//  Built-in verbs and their aliases.  Adding a row here is all it takes to
+//  add an alias; the perfect hash below is recomputed at compile time.
+//
+inline constexpr VerbEntry BUILTIN_VERBS[] = {
+    {"go",        VerbId::Go},
+    {"goto",      VerbId::Go},
+    {"move",      VerbId::Go},
+    {"travel",    VerbId::Travel},
+    {"look",      VerbId::Look},
+    {"inspect",   VerbId::Look},
+    {"search",    VerbId::Search},
+    {"take",      VerbId::Take},
+    {"get",       VerbId::Take},
+    {"drop",      VerbId::Drop},
+    {"inventory", VerbId::Inventory},
+    {"inv",       VerbId::Inventory},
+    {"help",      VerbId::Help},
+    {"quit",      VerbId::Quit},
+};
+
+// Seeded FNV-1a; the seed is what the table search below varies.
+constexpr std::uint32_t verbHash(std::string_view s, std::uint32_t seed) {
+    std::uint32_t h = 2166136261u ^ seed;
+    for (char c : s) {
+        h ^= static_cast<unsigned char>(c);
+        h *= 16777619u;
+    }
+    return h ^ (h >> 15);
+}
+
+//
+//  Collision-free slot table: hash(word, seed) & (Slots - 1) picks a slot,
+//  and the slot holds the index of the only word that can live there.
+//  A lookup is therefore one hash plus at most one string compare.
+//
+template <std::size_t N, std::size_t Slots>
+struct PerfectVerbHash {
+    static_assert((Slots & (Slots - 1)) == 0, "slot count must be a power of two");
+
+    std::uint32_t seed = 0;
+    std::array<std::int16_t, Slots> slots{};
+
+    constexpr std::optional<VerbId> find(std::string_view word,
+                                         const VerbEntry (&entries)[N]) const {
+        std::int16_t idx = slots[verbHash(word, seed) & (Slots - 1)];
+        if (idx >= 0 && entries[idx].word == word) {
+            return entries[idx].id;
+        }
+        return std::nullopt;
+    }
+};
+
+template <std::size_t Slots, std::size_t N>
+constexpr PerfectVerbHash<N, Slots> buildPerfectVerbHash(const VerbEntry (&entries)[N]) {
+    for (std::uint32_t seed = 1; seed < 100000; ++seed) {
+        PerfectVerbHash<N, Slots> table;
+        table.seed = seed;
+        table.slots.fill(-1);
+        bool collision = false;
+        for (std::size_t i = 0; i < N && !collision; ++i) {
+            auto &slot = table.slots[verbHash(entries[i].word, seed) & (Slots - 1)];
+            if (slot >= 0) collision = true;
+            else slot = static_cast<std::int16_t>(i);
+        }
+        if (!collision) return table;
+    }
+    return {}; // seed 0 marks "not found" and trips the static_assert below
+}
+
+inline constexpr auto VERB_HASH = buildPerfectVerbHash<32>(BUILTIN_VERBS);
+static_assert(VERB_HASH.seed != 0, "no perfect hash seed found; grow the slot count");
+
+// Resolve a (lowercased) verb to its built-in id, if it is one.
+constexpr std::optional<VerbId> findBuiltinVerb(std::string_view word) {
+    return VERB_HASH.find(word, BUILTIN_VERBS);
+}
+
+#endif // ZOORK_VERBTABLE_H
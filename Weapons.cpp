@@ -1,6 +1,6 @@
 //Weapons.cpp
 #include "Weapons.h"
-#include <iostream>
+#include "ObjectPool.h"
 
 Weapon::Weapon(WeaponType t)
     : type(t), reloading(false), scoped(false)
@@ -36,9 +36,9 @@ Weapon::Weapon(WeaponType t)
     }
 }
 
-bool Weapon::fireOne() {
+bool Weapon::fireOne(OutputSink& out) {
     if (ammo <= 0) {
-        std::cout << name << " is out of ammo and must reload!\n";
+        out.print("{} is out of ammo and must reload!\n", name);
         return false;
     }
     ammo--;
@@ -50,24 +50,30 @@ bool Weapon::fireOne() {
     return true;
 }
 
-void Weapon::reload() {
+void Weapon::reload(OutputSink& out) {
     if (ammo == maxAmmo) {
-        std::cout << name << " is already fully loaded.\n";
+        out.print("{} is already fully loaded.\n", name);
         return;
     }
     doReload();
-    std::cout << "Reloading " << name << "... (" << maxAmmo << " rounds)\n";
+    out.print("Reloading {}... ({} rounds)\n", name, maxAmmo);
     ammo = maxAmmo;
     reloading = false;
 }
 
-void Weapon::toggleScope() {
+void Weapon::toggleScope(OutputSink& out) {
     if (type != WeaponType::Rifle) {
-        std::cout << "Cannot scope with " << name << ".\n";
+        out.print("Cannot scope with {}.\n", name);
         return;
     }
     scoped = !scoped;
-    std::cout << (scoped ? "Scoped in on Rifle.\n" : "Scoped out.\n");
+    out.append(scoped ? "Scoped in on Rifle.\n" : "Scoped out.\n");
+}
+
+void Weapon::restoreState(int ammoLeft, bool isReloading, bool isScoped) {
+    ammo = ammoLeft < 0 ? 0 : (ammoLeft > maxAmmo ? maxAmmo : ammoLeft);
+    reloading = isReloading;
+    scoped = isScoped;
 }
 
 void Weapon::doReload() {
@@ -78,5 +84,5 @@ void Weapon::doReload() {
 // WeaponFactory
 // ——————————————————————————————————————————————————————————
 std::shared_ptr<Weapon> WeaponFactory::createWeapon(WeaponType type) {
-    return std::make_shared<Weapon>(type);
+    return makePooled<Weapon>(type);
 }
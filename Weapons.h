@@ -4,20 +4,12 @@
 #ifndef WEAPONS_H
 #define WEAPONS_H
 
+#include "ItemTypes.h"
+#include "OutputSink.h"
 #include <string>
 #include <memory>
 #include <random>
 
-// ——————————————
-// Four possible weapon types
-// ——————————————
-enum class WeaponType {
-    Rifle,
-    AssaultRifle,
-    Shotgun,
-    Pistol
-};
-
 // ——————————
 // Base Weapon class
 // ——————————
@@ -33,13 +25,17 @@ public:
     int                getMaxAmmo()  const { return maxAmmo; }
     bool               needsReload() const { return (ammo == 0) || reloading; }
     bool               isScoped()    const { return scoped; }
+    bool               isReloading() const { return reloading; }
 
     // Fire a single shot. Returns true if a shot was consumed.
-    bool fireOne();
+    bool fireOne(OutputSink& out);
     // Initiate reload sequence (refill ammo).
-    void reload();
+    void reload(OutputSink& out);
     // Toggle “scoped” state (for the bolt‐action rifle).
-    void toggleScope();
+    void toggleScope(OutputSink& out);
+
+    // Put back ammo/reload/scope state saved earlier (session snapshots)
+    void restoreState(int ammoLeft, bool isReloading, bool isScoped);
 
 protected:
     // Concrete subclasses will fill in 'name', 'baseDamage', 'baseAccuracy', 'maxAmmo', etc.
@@ -57,7 +53,7 @@ protected:
 };
 
 // —————————————————
-// Weapon factory stub
+// Weapon factory: weapons come from a per-thread pool (ObjectPool.h)
 // —————————————————
 struct WeaponFactory {
     static std::shared_ptr<Weapon> createWeapon(WeaponType type);
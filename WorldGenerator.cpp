@@ -0,0 +1,157 @@
+// File: WorldGenerator.cpp
+
+#include "WorldGenerator.h"
+#include "WorldImage.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+const char *const PLACES[] = {
+    "A narrow corridor", "A collapsed storeroom", "A flooded cellar", "A tiled washroom",
+    "A dusty archive", "A cramped office", "A ruined courtyard", "An abandoned workshop",
+};
+
+const char *const DETAILS[] = {
+    "lit by a flickering tube light.", "that smells of rust and mildew.",
+    "with scorch marks climbing the walls.", "where something scratches behind the plaster.",
+    "littered with broken glass.", "with a cold draught from nowhere.",
+    "under a sagging ceiling.", "strewn with old paperwork.",
+};
+
+const char *const OBJECTS[] = {
+    "crate", "locker", "desk", "cabinet", "pipe", "poster", "terminal", "bench",
+    "barrel", "shelf", "vent", "mirror", "cart", "bucket", "radio", "stretcher",
+};
+
+const char *const CONDITIONS[] = {
+    "dented and half rusted through", "covered in a thick layer of dust",
+    "stained with something dark", "oddly clean, as if recently used",
+};
+
+constexpr std::size_t countOf(const auto &array) { return sizeof(array) / sizeof(array[0]); }
+
+// Uniform in [0, n) without modulo bias worth caring about here, and the
+// same on every standard library (unlike std::uniform_int_distribution)
+std::uint32_t below(std::mt19937 &rng, std::uint32_t n) {
+    return static_cast<std::uint32_t>((static_cast<std::uint64_t>(rng()) * n) >> 32);
+}
+
+void addRandomPassage(std::vector<std::pair<std::uint32_t, std::uint32_t>> &extra, std::uint32_t from,
+                      std::mt19937 &rng, std::uint32_t rooms) {
+    std::uint32_t to = below(rng, rooms);
+    if (to == from) return;
+    extra.emplace_back(from, to);
+    extra.emplace_back(to, from);
+}
+
+} // namespace
+
+std::string WorldGenerator::roomName(std::uint32_t id, std::uint32_t rooms) {
+    std::string digits = std::to_string(id);
+    std::size_t width = std::max<std::size_t>(6, std::to_string(rooms > 0 ? rooms - 1 : 0).size());
+    return "Room " + std::string(width > digits.size() ? width - digits.size() : 0, '0') + digits;
+}
+
+bool WorldGenerator::parseLayout(std::string_view name, WorldShape::Layout &layout) {
+    if (name == "ring") layout = WorldShape::Layout::Ring;
+    else if (name == "grid") layout = WorldShape::Layout::Grid;
+    else if (name == "smallworld") layout = WorldShape::Layout::SmallWorld;
+    else return false;
+    return true;
+}
+
+const char *WorldGenerator::layoutName(WorldShape::Layout layout) {
+    switch (layout) {
+        case WorldShape::Layout::Ring: return "ring";
+        case WorldShape::Layout::Grid: return "grid";
+        case WorldShape::Layout::SmallWorld: return "smallworld";
+    }
+    return "?";
+}
+
+bool WorldGenerator::generate(const WorldShape &shape, std::string &image, std::string &error) {
+    const std::uint32_t n = shape.rooms;
+    if (n == 0) {
+        error = "a world needs at least one room";
+        return false;
+    }
+    if (shape.objectsPerRoom > 0xffff) {
+        error = "too many objects per room";
+        return false;
+    }
+    std::mt19937 rng(shape.seed);
+
+    // Passages beyond the layout's own, both directions, grouped by room
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> extra;
+    if (shape.layout == WorldShape::Layout::SmallWorld && n > 2) {
+        auto count = static_cast<std::uint64_t>(std::llround(shape.shortcuts * n));
+        extra.reserve(count * 2);
+        for (std::uint64_t i = 0; i < count; ++i) {
+            addRandomPassage(extra, below(rng, n), rng, n);
+        }
+    }
+    for (std::uint32_t h = 0; h < shape.hubs && h < n; ++h) {
+        auto hub = static_cast<std::uint32_t>(static_cast<std::uint64_t>(h) * n / std::min(shape.hubs, n));
+        for (std::uint32_t d = 0; d < shape.hubDegree; ++d) {
+            addRandomPassage(extra, hub, rng, n);
+        }
+    }
+    std::sort(extra.begin(), extra.end());
+
+    // Text pools: every room draws from them, so the image stores each
+    // description and object text once however large the world gets
+    std::vector<std::string> descriptions;
+    for (const char *place : PLACES) {
+        for (const char *detail : DETAILS) descriptions.push_back(std::string(place) + " " + detail);
+    }
+    std::vector<std::string> lookTexts;
+    std::vector<std::string> searchTexts;
+    for (const char *object : OBJECTS) {
+        for (const char *condition : CONDITIONS) {
+            lookTexts.push_back("The " + std::string(object) + " is " + condition + ".");
+        }
+        searchTexts.push_back("You search the " + std::string(object) + " but find nothing useful.");
+    }
+
+    const auto width = static_cast<std::uint32_t>(std::ceil(std::sqrt(static_cast<double>(n))));
+    WorldImage::Writer writer;
+    std::vector<std::uint32_t> neighbours;
+    auto nextExtra = extra.begin();
+    std::string objectName;
+    for (std::uint32_t id = 0; id < n; ++id) {
+        writer.addRoom(roomName(id, n), descriptions[below(rng, static_cast<std::uint32_t>(descriptions.size()))]);
+
+        std::uint32_t first = below(rng, countOf(OBJECTS));
+        for (std::uint32_t k = 0; k < shape.objectsPerRoom; ++k) {
+            std::uint32_t object = (first + k) % countOf(OBJECTS);
+            objectName = OBJECTS[object];
+            if (k >= countOf(OBJECTS)) objectName += " " + std::to_string(k / countOf(OBJECTS) + 1);
+            writer.addLook(objectName, lookTexts[object * countOf(CONDITIONS) + below(rng, countOf(CONDITIONS))]);
+            if (rng() & 1) writer.addSearch(objectName, searchTexts[object]);
+        }
+
+        neighbours.clear();
+        if (shape.layout == WorldShape::Layout::Grid) {
+            if (id % width > 0) neighbours.push_back(id - 1);
+            if (id % width + 1 < width && id + 1 < n) neighbours.push_back(id + 1);
+            if (id >= width) neighbours.push_back(id - width);
+            if (id + width < n) neighbours.push_back(id + width);
+        } else if (n > 1) {
+            neighbours.push_back(id == 0 ? n - 1 : id - 1);
+            neighbours.push_back(id + 1 == n ? 0 : id + 1);
+        }
+        for (; nextExtra != extra.end() && nextExtra->first == id; ++nextExtra) {
+            neighbours.push_back(nextExtra->second);
+        }
+        std::sort(neighbours.begin(), neighbours.end());
+        neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+        for (std::uint32_t to : neighbours) {
+            if (to != id) writer.addExit(to, roomName(to, n));
+        }
+    }
+    return writer.finish(0, image, error);
+}
@@ -0,0 +1,56 @@
+// File: WorldGenerator.h
+
+#ifndef ZOORK_WORLDGENERATOR_H
+#define ZOORK_WORLDGENERATOR_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+//
+//  Shape of a generated world.  Every layout is connected and every passage
+//  goes both ways:
+//
+//      Ring        room i next to rooms i-1 and i+1
+//      Grid        a square-ish grid, up to four neighbours per room
+//      SmallWorld  a ring plus `shortcuts` random long-range passages per
+//                  room (Watts-Strogatz style, without rewiring)
+//
+//  On top of any layout, `hubs` rooms (spread evenly over the ids) each get
+//  `hubDegree` extra passages to random rooms.
+//
+struct WorldShape {
+    enum class Layout { Ring, Grid, SmallWorld };
+
+    Layout layout = Layout::Ring;
+    std::uint32_t rooms = 1000;
+    std::uint32_t objectsPerRoom = 2;   // lookables; about half are searchable too
+    double shortcuts = 0.1;             // SmallWorld only
+    std::uint32_t hubs = 0;
+    std::uint32_t hubDegree = 0;
+    std::uint32_t seed = 1;
+};
+
+//
+//  Seeded generator of synthetic worlds, for testing the engine and server
+//  at sizes far beyond the built-in world (10^3 to 10^6 rooms).  The same
+//  shape always gives the same image byte for byte.
+//
+//  Worlds are written straight to a WorldImage, so they can be saved with
+//  ZOOrkWorldgen and played with --world, or loaded in-process with
+//  WorldManager::fromImage().  Rooms are named "Room 000000", "Room 000001",
+//  ... (zero-padded, so name order is id order), start at room 0, and every
+//  passage is labelled with its destination's name as in longxue.world.
+//
+struct WorldGenerator {
+    static bool generate(const WorldShape &shape, std::string &image, std::string &error);
+
+    // Name of room `id` in a world of `rooms` rooms
+    static std::string roomName(std::uint32_t id, std::uint32_t rooms);
+
+    // "ring", "grid" or "smallworld"
+    static bool parseLayout(std::string_view name, WorldShape::Layout &layout);
+    static const char *layoutName(WorldShape::Layout layout);
+};
+
+#endif // ZOORK_WORLDGENERATOR_H
@@ -0,0 +1,796 @@
+// File: WorldImage.cpp
+
+#include "WorldImage.h"
+#include "EnemyTypes.h"
+#include "ItemTypes.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <map>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include <zlib.h>
+
+namespace {
+
+constexpr char MAGIC[4] = {'Z', 'K', 'W', 'D'};
+
+static_assert(sizeof(WorldImage::Header) == 72);
+static_assert(sizeof(WorldImage::RoomRecord) == 32);
+static_assert(sizeof(WorldImage::ExitRecord) == 16);
+static_assert(sizeof(WorldImage::EncounterRecord) == 56);
+static_assert(sizeof(WorldImage::ItemRecord) == 40);
+static_assert(sizeof(WorldImage::SpawnRecord) == 40);
+static_assert(std::is_trivially_copyable_v<WorldImage::Header>);
+static_assert(std::is_trivially_copyable_v<WorldImage::RoomRecord>);
+
+template <typename T>
+T readRecord(std::string_view image, std::size_t offset) {
+    T value;
+    std::memcpy(&value, image.data() + offset, sizeof(T));
+    return value;
+}
+
+template <typename T>
+void appendRecord(std::string &image, const T &value) {
+    image.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+//
+//  Source form, while compiling
+//
+// What searching an object reveals
+struct SourceSpawn {
+    std::string name;
+    std::string look;
+    std::string search;
+    bool hasSearch = false;
+    int line;
+};
+
+struct SourceDetail {
+    std::string name;
+    std::string text;
+    int line;
+    std::vector<SourceSpawn> reveals;   // searches only
+};
+
+struct SourceExit {
+    std::string room;
+    int line;
+};
+
+struct SourceEncounter {
+    EnemyType foe;
+    std::string intro;
+    std::string defeat;
+    std::string victory;
+    std::string lootName;
+    std::string lootLook;
+    std::string lootSearch;
+    bool hasLootLook = false;
+    bool hasLootSearch = false;
+    int line = 0;   // 0: the room has none
+};
+
+struct SourceItem {
+    std::string object;
+    std::string name;
+    std::string description;
+    ItemType type = ItemType::Generic;
+    WeaponType weapon = WeaponType::Pistol;
+    int value = 0;
+    bool hasKind = false;
+    bool hasDescription = false;
+    int line = 0;
+};
+
+struct SourceRoom {
+    std::string name;
+    std::string description;
+    std::vector<SourceDetail> looks;
+    std::vector<SourceDetail> searches;
+    std::vector<SourceExit> exits;
+    SourceEncounter encounter;
+    bool gated = false;
+};
+
+std::string_view trimLeft(std::string_view s) {
+    while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) s.remove_prefix(1);
+    return s;
+}
+
+std::string_view trimRight(std::string_view s) {
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\r')) s.remove_suffix(1);
+    return s;
+}
+
+bool fail(std::string &error, int line, std::string_view message) {
+    error = "line " + std::to_string(line) + ": ";
+    error.append(message);
+    return false;
+}
+
+// "<name>: <text>" split at the colon; false if there is none
+bool splitNamed(std::string_view rest, std::string_view &name, std::string_view &text) {
+    std::size_t colon = rest.find(':');
+    if (colon == std::string_view::npos) return false;
+    name = trimRight(rest.substr(0, colon));
+    text = rest.substr(colon + 1);
+    if (!text.empty() && text.front() == ' ') text.remove_prefix(1);
+    return true;
+}
+
+// Sort a room's looks or searches by name; duplicates are an error
+bool sortDetails(std::vector<SourceDetail> &details, std::string_view room, std::string &error) {
+    std::stable_sort(details.begin(), details.end(),
+                     [](const SourceDetail &a, const SourceDetail &b) { return a.name < b.name; });
+    for (std::size_t i = 1; i < details.size(); ++i) {
+        if (details[i].name == details[i - 1].name) {
+            return fail(error, details[i].line,
+                        "\"" + details[i].name + "\" is described twice in room \"" + std::string(room) + "\"");
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+bool WorldImage::compile(std::string_view source, std::string &image, std::string &error) {
+    std::vector<SourceRoom> rooms;
+    std::unordered_set<std::string> roomNames;
+    std::vector<SourceItem> items;
+    std::unordered_set<std::string> itemObjects;
+    std::unordered_set<std::string> itemNames;
+    enum class Block { None, Room, Item } block = Block::None;   // what the lines below belong to
+    bool afterSearch = false;           // the last line was a search or one of its reveals
+    std::string startRoom;
+    int startLine = 0;
+    std::string *continued = nullptr;   // what a "|" line appends to
+    bool freshText = false;             // ... and it has no line yet
+
+    int lineNo = 0;
+    while (!source.empty()) {
+        ++lineNo;
+        std::size_t nl = source.find('\n');
+        std::string_view raw = source.substr(0, nl);
+        source.remove_prefix(nl == std::string_view::npos ? source.size() : nl + 1);
+        if (!raw.empty() && raw.back() == '\r') raw.remove_suffix(1);
+
+        std::string_view line = trimLeft(raw);
+        if (line.empty() || line.front() == '#') continue;
+
+        if (line.front() == '|') {
+            if (!continued) return fail(error, lineNo, "\"|\" line with nothing to continue");
+            line.remove_prefix(1);
+            if (!line.empty() && line.front() == ' ') line.remove_prefix(1);
+            if (!freshText) continued->push_back('\n');
+            freshText = false;
+            continued->append(line);
+            continue;
+        }
+
+        std::size_t space = line.find_first_of(" :");
+        std::string_view keyword = line.substr(0, space);
+        std::string_view rest = space == std::string_view::npos ? std::string_view() : trimRight(trimLeft(line.substr(space)));
+        bool revealing = afterSearch;
+        afterSearch = false;
+
+        if (keyword == "start") {
+            if (rest.empty()) return fail(error, lineNo, "\"start\" needs a room name");
+            startRoom.assign(rest);
+            startLine = lineNo;
+            continued = nullptr;
+        }
+        else if (keyword == "room") {
+            if (rest.empty()) return fail(error, lineNo, "\"room\" needs a name");
+            if (!roomNames.emplace(rest).second) {
+                return fail(error, lineNo, "room \"" + std::string(rest) + "\" defined twice");
+            }
+            rooms.emplace_back();
+            rooms.back().name.assign(rest);
+            block = Block::Room;
+            continued = &rooms.back().description;
+            freshText = true;
+        }
+        else if (keyword == "look" || keyword == "search") {
+            if (block != Block::Room) return fail(error, lineNo, "\"" + std::string(keyword) + "\" outside a room");
+            std::string_view name, text;
+            if (!splitNamed(rest, name, text)) return fail(error, lineNo, "expected \"<object>: <text>\"");
+            if (name.empty()) return fail(error, lineNo, "missing object name");
+
+            auto &details = keyword == "look" ? rooms.back().looks : rooms.back().searches;
+            details.push_back(SourceDetail{std::string(name), std::string(text), lineNo, {}});
+            continued = &details.back().text;
+            freshText = false;
+            afterSearch = keyword == "search";
+        }
+        else if (keyword == "gated") {
+            if (block != Block::Room) return fail(error, lineNo, "\"gated\" outside a room");
+            if (!rest.empty()) return fail(error, lineNo, "\"gated\" takes nothing more");
+            rooms.back().gated = true;
+            continued = nullptr;
+        }
+        else if (keyword == "exit") {
+            if (block != Block::Room) return fail(error, lineNo, "\"exit\" outside a room");
+            if (rest.empty()) return fail(error, lineNo, "\"exit\" needs a room name");
+            rooms.back().exits.push_back(SourceExit{std::string(rest), lineNo});
+            continued = nullptr;
+        }
+        else if (keyword == "encounter") {
+            if (block != Block::Room) return fail(error, lineNo, "\"encounter\" outside a room");
+            SourceEncounter &encounter = rooms.back().encounter;
+            if (encounter.line) return fail(error, lineNo, "room \"" + rooms.back().name + "\" already has an encounter");
+            std::string_view foe, text;
+            if (!splitNamed(rest, foe, text)) return fail(error, lineNo, "expected \"encounter <foe>: <text>\"");
+            if (!enemyTypeByName(foe, encounter.foe)) return fail(error, lineNo, "unknown foe \"" + std::string(foe) + "\"");
+            encounter.line = lineNo;
+            encounter.intro.assign(text);
+            continued = &encounter.intro;
+            freshText = false;
+        }
+        else if (keyword == "defeat" || keyword == "victory") {
+            if (block != Block::Room || !rooms.back().encounter.line) {
+                return fail(error, lineNo, "\"" + std::string(keyword) + "\" before this room's \"encounter\"");
+            }
+            std::string_view name, text;
+            if (!splitNamed(rest, name, text) || !name.empty()) return fail(error, lineNo, "expected \"" + std::string(keyword) + ": <text>\"");
+            SourceEncounter &encounter = rooms.back().encounter;
+            continued = keyword == "defeat" ? &encounter.defeat : &encounter.victory;
+            continued->assign(text);
+            freshText = false;
+        }
+        else if (keyword == "loot") {
+            if (block != Block::Room || !rooms.back().encounter.line) return fail(error, lineNo, "\"loot\" before this room's \"encounter\"");
+            std::size_t kindEnd = rest.find(' ');
+            std::string_view kind = rest.substr(0, kindEnd);
+            std::string_view name, text;
+            if ((kind != "look" && kind != "search") || kindEnd == std::string_view::npos
+                || !splitNamed(rest.substr(kindEnd + 1), name, text)) {
+                return fail(error, lineNo, "expected \"loot look <object>: <text>\" or \"loot search <object>: <text>\"");
+            }
+            if (name.empty()) return fail(error, lineNo, "missing object name");
+            SourceEncounter &encounter = rooms.back().encounter;
+            if ((encounter.hasLootLook || encounter.hasLootSearch) && name != encounter.lootName) {
+                return fail(error, lineNo, "the encounter leaves \"" + encounter.lootName + "\", not \"" + std::string(name) + "\"");
+            }
+            encounter.lootName.assign(name);
+            (kind == "look" ? encounter.hasLootLook : encounter.hasLootSearch) = true;
+            continued = kind == "look" ? &encounter.lootLook : &encounter.lootSearch;
+            continued->assign(text);
+            freshText = false;
+        }
+        else if (keyword == "reveal") {
+            if (block != Block::Room || !revealing) return fail(error, lineNo, "\"reveal\" must follow a \"search\" line");
+            std::size_t kindEnd = rest.find(' ');
+            std::string_view kind = rest.substr(0, kindEnd);
+            std::string_view name, text;
+            if ((kind != "look" && kind != "search") || kindEnd == std::string_view::npos
+                || !splitNamed(rest.substr(kindEnd + 1), name, text)) {
+                return fail(error, lineNo, "expected \"reveal look <object>: <text>\" or \"reveal search <object>: <text>\"");
+            }
+            if (name.empty()) return fail(error, lineNo, "missing object name");
+            std::vector<SourceSpawn> &reveals = rooms.back().searches.back().reveals;
+            if (kind == "look") {
+                if (!reveals.empty() && !reveals.back().hasSearch) {
+                    return fail(error, reveals.back().line, "\"" + reveals.back().name + "\" has no \"reveal search\" line");
+                }
+                reveals.push_back(SourceSpawn{std::string(name), std::string(text), std::string(), false, lineNo});
+                continued = &reveals.back().look;
+            } else {
+                if (reveals.empty() || reveals.back().hasSearch || reveals.back().name != name) {
+                    return fail(error, lineNo, "\"reveal search " + std::string(name) + "\" must follow \"reveal look "
+                                                   + std::string(name) + "\"");
+                }
+                reveals.back().search.assign(text);
+                reveals.back().hasSearch = true;
+                continued = &reveals.back().search;
+            }
+            freshText = false;
+            afterSearch = true;
+        }
+        else if (keyword == "item") {
+            std::string_view object, name;
+            if (!splitNamed(rest, object, name) || object.empty() || name.empty()) {
+                return fail(error, lineNo, "expected \"item <object>: <name>\"");
+            }
+            if (!itemObjects.emplace(object).second) return fail(error, lineNo, "\"" + std::string(object) + "\" is already an item");
+            if (!itemNames.emplace(name).second) return fail(error, lineNo, "item \"" + std::string(name) + "\" defined twice");
+            SourceItem &item = items.emplace_back();
+            item.object.assign(object);
+            item.name.assign(name);
+            item.line = lineNo;
+            block = Block::Item;
+            continued = nullptr;
+        }
+        else if (keyword == "kind") {
+            if (block != Block::Item) return fail(error, lineNo, "\"kind\" outside an item");
+            SourceItem &item = items.back();
+            if (item.hasKind) return fail(error, lineNo, "item \"" + item.name + "\" already has a kind");
+            std::size_t typeEnd = rest.find(' ');
+            std::string_view type = rest.substr(0, typeEnd);
+            std::string_view arg = typeEnd == std::string_view::npos ? std::string_view() : trimLeft(rest.substr(typeEnd));
+            if (!itemTypeByName(type, item.type)) return fail(error, lineNo, "unknown item kind \"" + std::string(type) + "\"");
+            if (item.type == ItemType::Weapon) {
+                std::string_view weapon = arg.substr(0, arg.find(' '));
+                if (!weaponTypeByName(weapon, item.weapon)) return fail(error, lineNo, "unknown weapon \"" + std::string(weapon) + "\"");
+                if (weapon.size() != arg.size()) {
+                    return fail(error, lineNo, "weapons come with a full magazine; \"kind Weapon\" takes only the weapon");
+                }
+            } else if (item.type == ItemType::Armor || item.type == ItemType::Medkit) {
+                auto [end, ec] = std::from_chars(arg.data(), arg.data() + arg.size(), item.value);
+                if (arg.empty() || ec != std::errc() || end != arg.data() + arg.size()) {
+                    return fail(error, lineNo, "\"kind " + std::string(type) + "\" needs a number");
+                }
+            } else if (!arg.empty()) {
+                return fail(error, lineNo, "\"kind " + std::string(type) + "\" takes nothing more");
+            }
+            item.hasKind = true;
+            continued = nullptr;
+        }
+        else if (keyword == "description") {
+            if (block != Block::Item) return fail(error, lineNo, "\"description\" outside an item");
+            std::string_view name, text;
+            if (!splitNamed(rest, name, text) || !name.empty()) return fail(error, lineNo, "expected \"description: <text>\"");
+            SourceItem &item = items.back();
+            item.description.assign(text);
+            item.hasDescription = true;
+            continued = &item.description;
+            freshText = false;
+        }
+        else {
+            return fail(error, lineNo, "unknown keyword \"" + std::string(keyword) + "\"");
+        }
+    }
+
+    if (rooms.empty()) return fail(error, lineNo, "no rooms");
+    if (startRoom.empty()) return fail(error, lineNo, "no \"start\" room");
+
+    // Rooms are stored in name order, so RoomIds follow it
+    std::sort(rooms.begin(), rooms.end(),
+              [](const SourceRoom &a, const SourceRoom &b) { return a.name < b.name; });
+    std::map<std::string_view, std::uint32_t> roomIndex;
+    for (std::uint32_t i = 0; i < rooms.size(); ++i) {
+        roomIndex.emplace(rooms[i].name, i);
+    }
+    auto start = roomIndex.find(startRoom);
+    if (start == roomIndex.end()) return fail(error, startLine, "unknown start room \"" + startRoom + "\"");
+
+    Writer writer;
+    for (const SourceItem &item : items) {
+        if (!item.hasKind) return fail(error, item.line, "item \"" + item.name + "\" has no \"kind\" line");
+        if (!item.hasDescription) return fail(error, item.line, "item \"" + item.name + "\" has no \"description\" line");
+        writer.addItem(ItemDefinition{item.object, item.name, item.description, static_cast<std::uint32_t>(item.type),
+                                      static_cast<std::uint32_t>(item.weapon), item.value});
+    }
+    for (SourceRoom &r : rooms) {
+        if (!sortDetails(r.looks, r.name, error) || !sortDetails(r.searches, r.name, error)) return false;
+
+        writer.addRoom(r.name, r.description, r.gated ? ROOM_GATED : 0);
+        for (const SourceDetail &d : r.looks) writer.addLook(d.name, d.text);
+        for (const SourceDetail &d : r.searches) writer.addSearch(d.name, d.text);
+        for (const SourceDetail &d : r.searches) {
+            for (const SourceSpawn &spawn : d.reveals) {
+                if (!spawn.hasSearch) return fail(error, spawn.line, "\"" + spawn.name + "\" has no \"reveal search\" line");
+                writer.addSpawn(d.name, spawn.name, spawn.look, spawn.search);
+            }
+        }
+        for (const SourceExit &e : r.exits) {
+            auto to = roomIndex.find(e.room);
+            if (to == roomIndex.end()) return fail(error, e.line, "exit to unknown room \"" + e.room + "\"");
+            writer.addExit(to->second, e.room);
+        }
+
+        const SourceEncounter &en = r.encounter;
+        if (en.line) {
+            const char *missing = en.defeat.empty() ? "defeat" : en.victory.empty() ? "victory"
+                                : !en.hasLootLook ? "loot look" : !en.hasLootSearch ? "loot search" : nullptr;
+            if (missing) {
+                return fail(error, en.line, "encounter in room \"" + r.name + "\" has no \"" + missing + "\" line");
+            }
+            writer.addEncounter(static_cast<std::uint32_t>(en.foe),
+                                EncounterText{en.intro, en.defeat, en.victory, en.lootName, en.lootLook, en.lootSearch});
+        }
+    }
+    return writer.finish(start->second, image, error);
+}
+
+//
+//  zlib stream state, kept from one room to the next
+//
+struct WorldImage::Writer::Stream {
+    z_stream z{};
+    bool ready = deflateInit(&z, Z_DEFAULT_COMPRESSION) == Z_OK;
+    ~Stream() {
+        if (ready) deflateEnd(&z);
+    }
+};
+
+struct WorldImage::ContentReader::Stream {
+    z_stream z{};
+    bool ready = inflateInit(&z) == Z_OK;
+    ~Stream() {
+        if (ready) inflateEnd(&z);
+    }
+};
+
+WorldImage::Writer::Writer() : stream(std::make_unique<Stream>()) {}
+WorldImage::Writer::~Writer() = default;
+
+WorldImage::StringRef WorldImage::Writer::addString(std::string_view s) {
+    auto it = stringIndex.find(std::string(s));
+    if (it != stringIndex.end()) return it->second;
+    StringRef ref{static_cast<std::uint32_t>(strings.size()), static_cast<std::uint32_t>(s.size())};
+    strings.append(s);
+    stringIndex.emplace(std::string(s), ref);
+    return ref;
+}
+
+std::uint32_t WorldImage::Writer::addRoom(std::string_view name, std::string_view text, std::uint32_t flags) {
+    flushRoom();
+    if (!rooms.empty() && name <= lastName && problem.empty()) {
+        problem = "room \"" + std::string(name) + "\" added out of name order";
+    }
+    lastName.assign(name);
+
+    RoomRecord rec{};
+    rec.name = addString(name);
+    rec.firstExit = static_cast<std::uint32_t>(exits.size());
+    rec.flags = flags;
+    rooms.push_back(rec);
+    description.assign(text);
+    return static_cast<std::uint32_t>(rooms.size() - 1);
+}
+
+void WorldImage::Writer::addLook(std::string_view name, std::string_view text) {
+    looks.emplace_back(name, text);
+}
+
+void WorldImage::Writer::addSearch(std::string_view name, std::string_view text) {
+    searches.emplace_back(name, text);
+}
+
+void WorldImage::Writer::addExit(std::uint32_t toRoom, std::string_view label) {
+    if (rooms.empty()) {
+        if (problem.empty()) problem = "exit before the first room";
+        return;
+    }
+    exits.push_back(ExitRecord{toRoom, 0, addString(label)});
+    rooms.back().exitCount++;
+}
+
+void WorldImage::Writer::addEncounter(std::uint32_t foe, const EncounterText &text) {
+    if (!problem.empty()) return;
+    auto room = static_cast<std::uint32_t>(rooms.size() - 1);
+    if (rooms.empty()) {
+        problem = "encounter before the first room";
+    } else if (!encounters.empty() && encounters.back().room == room) {
+        problem = "two encounters in room " + std::to_string(room);
+    } else if (encounters.size() == MAX_ENCOUNTERS) {
+        problem = "more than " + std::to_string(MAX_ENCOUNTERS) + " encounters";
+    } else if (foe >= ENEMY_TYPE_COUNT) {
+        problem = "unknown foe " + std::to_string(foe) + " in room " + std::to_string(room);
+    } else {
+        encounters.push_back(EncounterRecord{room, foe, addString(text.intro), addString(text.defeat),
+                                             addString(text.victory), addString(text.lootName),
+                                             addString(text.lootLook), addString(text.lootSearch)});
+    }
+}
+
+void WorldImage::Writer::addSpawn(std::string_view searchable, std::string_view name, std::string_view look,
+                                  std::string_view search) {
+    if (rooms.empty()) {
+        if (problem.empty()) problem = "spawn before the first room";
+        return;
+    }
+    spawns.push_back(SpawnRecord{static_cast<std::uint32_t>(rooms.size() - 1), 0, addString(searchable),
+                                 addString(name), addString(look), addString(search)});
+}
+
+void WorldImage::Writer::addItem(const ItemDefinition &item) {
+    if (!problem.empty()) return;
+    if (items.size() == MAX_ITEMS) {
+        problem = "more than " + std::to_string(MAX_ITEMS) + " items";
+    } else if (item.type >= ITEM_TYPE_COUNT || item.weapon >= WEAPON_TYPE_COUNT) {
+        problem = "item \"" + std::string(item.name) + "\" has an unknown kind";
+    } else if (item.type == static_cast<std::uint32_t>(ItemType::Weapon) && item.value != 0) {
+        problem = "weapon \"" + std::string(item.name) + "\" given a value; weapons come with a full magazine";
+    } else if (!itemObjects.emplace(item.object).second) {
+        problem = "\"" + std::string(item.object) + "\" is taken as two items";
+    } else if (!itemNames.emplace(item.name).second) {
+        problem = "item \"" + std::string(item.name) + "\" added twice";
+    } else {
+        items.push_back(ItemRecord{addString(item.object), addString(item.name), addString(item.description),
+                                   item.type, item.weapon, item.value, 0});
+    }
+}
+
+void WorldImage::Writer::flushRoom() {
+    if (rooms.empty()) return;
+    RoomRecord &room = rooms.back();
+    if (looks.size() > UINT16_MAX || searches.size() > UINT16_MAX) {
+        if (problem.empty()) problem = "too many objects in room " + std::to_string(rooms.size() - 1);
+    }
+
+    // Each run sorted by object name, so rooms can binary-search them
+    for (auto *details : {&looks, &searches}) {
+        std::stable_sort(details->begin(), details->end(),
+                         [](const auto &a, const auto &b) { return a.first < b.first; });
+        for (std::size_t i = 1; i < details->size(); ++i) {
+            if ((*details)[i].first == (*details)[i - 1].first && problem.empty()) {
+                problem = "object described twice in room " + std::to_string(rooms.size() - 1);
+            }
+        }
+    }
+
+    unpacked.clear();
+    appendRecord(unpacked, static_cast<std::uint32_t>(description.size()));
+    appendRecord(unpacked, static_cast<std::uint16_t>(looks.size()));
+    appendRecord(unpacked, static_cast<std::uint16_t>(searches.size()));
+    for (auto *details : {&looks, &searches}) {
+        for (const auto &d : *details) {
+            appendRecord(unpacked, static_cast<std::uint32_t>(d.first.size()));
+            appendRecord(unpacked, static_cast<std::uint32_t>(d.second.size()));
+        }
+    }
+    unpacked.append(description);
+    for (auto *details : {&looks, &searches}) {
+        for (const auto &d : *details) {
+            unpacked.append(d.first);
+            unpacked.append(d.second);
+        }
+        details->clear();
+    }
+    if (unpacked.size() > MAX_CONTENT_SIZE && problem.empty()) {
+        problem = "too much text in room " + std::to_string(rooms.size() - 1);
+    }
+
+    // Compressed, unless that does not make it any smaller
+    std::string_view stored = unpacked;
+    z_stream &z = stream->z;
+    if (stream->ready && deflateReset(&z) == Z_OK) {
+        packed.resize(deflateBound(&z, static_cast<uLong>(unpacked.size())));
+        z.next_in = reinterpret_cast<Bytef *>(unpacked.data());
+        z.avail_in = static_cast<uInt>(unpacked.size());
+        z.next_out = reinterpret_cast<Bytef *>(packed.data());
+        z.avail_out = static_cast<uInt>(packed.size());
+        if (deflate(&z, Z_FINISH) == Z_STREAM_END && z.total_out < unpacked.size()) {
+            stored = std::string_view(packed).substr(0, z.total_out);
+        }
+    }
+    room.content = ContentRef{static_cast<std::uint32_t>(content.size()), static_cast<std::uint32_t>(stored.size()),
+                              static_cast<std::uint32_t>(unpacked.size())};
+    content.append(stored);
+    if (content.size() > UINT32_MAX && problem.empty()) problem = "world image would exceed 4 GiB";
+}
+
+bool WorldImage::Writer::finish(std::uint32_t startRoom, std::string &image, std::string &error) {
+    flushRoom();
+    if (problem.empty() && rooms.empty()) problem = "no rooms";
+    if (problem.empty() && startRoom >= rooms.size()) problem = "start room out of range";
+    for (const ExitRecord &e : exits) {
+        if (problem.empty() && e.toRoom >= rooms.size()) problem = "exit to room " + std::to_string(e.toRoom) + ", which does not exist";
+    }
+    std::uint64_t total = sizeof(Header) + rooms.size() * sizeof(RoomRecord) + exits.size() * sizeof(ExitRecord)
+                        + encounters.size() * sizeof(EncounterRecord) + items.size() * sizeof(ItemRecord)
+                        + spawns.size() * sizeof(SpawnRecord) + content.size() + strings.size();
+    if (problem.empty() && total > UINT32_MAX) problem = "world image would exceed 4 GiB";
+    if (!problem.empty()) {
+        error = problem;
+        return false;
+    }
+
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.startRoom = startRoom;
+    header.roomCount = static_cast<std::uint32_t>(rooms.size());
+    header.roomsOffset = sizeof(Header);
+    header.exitCount = static_cast<std::uint32_t>(exits.size());
+    header.exitsOffset = header.roomsOffset + header.roomCount * sizeof(RoomRecord);
+    header.encounterCount = static_cast<std::uint32_t>(encounters.size());
+    header.encountersOffset = header.exitsOffset + header.exitCount * sizeof(ExitRecord);
+    header.itemCount = static_cast<std::uint32_t>(items.size());
+    header.itemsOffset = header.encountersOffset + header.encounterCount * sizeof(EncounterRecord);
+    header.spawnCount = static_cast<std::uint32_t>(spawns.size());
+    header.spawnsOffset = header.itemsOffset + header.itemCount * sizeof(ItemRecord);
+    header.contentOffset = header.spawnsOffset + header.spawnCount * sizeof(SpawnRecord);
+    header.contentSize = static_cast<std::uint32_t>(content.size());
+    header.stringsOffset = header.contentOffset + header.contentSize;
+    header.stringsSize = static_cast<std::uint32_t>(strings.size());
+    header.totalSize = static_cast<std::uint32_t>(total);
+
+    image.clear();
+    image.reserve(total);
+    appendRecord(image, header);
+    image.append(reinterpret_cast<const char *>(rooms.data()), rooms.size() * sizeof(RoomRecord));
+    image.append(reinterpret_cast<const char *>(exits.data()), exits.size() * sizeof(ExitRecord));
+    image.append(reinterpret_cast<const char *>(encounters.data()), encounters.size() * sizeof(EncounterRecord));
+    image.append(reinterpret_cast<const char *>(items.data()), items.size() * sizeof(ItemRecord));
+    image.append(reinterpret_cast<const char *>(spawns.data()), spawns.size() * sizeof(SpawnRecord));
+    image.append(content);
+    image.append(strings);
+    return true;
+}
+
+bool WorldImage::validate(std::string_view image, std::string &error) {
+    if (image.size() < sizeof(Header)) {
+        error = "too short for a world image";
+        return false;
+    }
+    Header h = readRecord<Header>(image, 0);
+    if (std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        error = "not a world image";
+        return false;
+    }
+    if (h.version != VERSION) {
+        error = "world image version " + std::to_string(h.version) + ", expected " + std::to_string(VERSION);
+        return false;
+    }
+
+    auto tableFits = [&](std::uint64_t offset, std::uint64_t count, std::uint64_t size) {
+        return offset >= sizeof(Header) && offset + count * size <= h.contentOffset;
+    };
+    if (h.totalSize != image.size()
+        || std::uint64_t{h.stringsOffset} + h.stringsSize != h.totalSize
+        || h.contentOffset < sizeof(Header)
+        || std::uint64_t{h.contentOffset} + h.contentSize > h.stringsOffset
+        || !tableFits(h.roomsOffset, h.roomCount, sizeof(RoomRecord))
+        || !tableFits(h.exitsOffset, h.exitCount, sizeof(ExitRecord))
+        || !tableFits(h.encountersOffset, h.encounterCount, sizeof(EncounterRecord))
+        || h.encounterCount > MAX_ENCOUNTERS
+        || !tableFits(h.itemsOffset, h.itemCount, sizeof(ItemRecord))
+        || !tableFits(h.spawnsOffset, h.spawnCount, sizeof(SpawnRecord))
+        || h.itemCount > MAX_ITEMS
+        || h.roomCount == 0 || h.startRoom >= h.roomCount) {
+        error = "world image tables out of bounds";
+        return false;
+    }
+
+    auto refFits = [&](StringRef r) {
+        return std::uint64_t{r.offset} + r.length <= h.stringsSize;
+    };
+    std::uint64_t nextExit = 0;   // exits are grouped by room, in id order
+    for (std::uint32_t i = 0; i < h.roomCount; ++i) {
+        auto r = readRecord<RoomRecord>(image, h.roomsOffset + std::size_t{i} * sizeof(RoomRecord));
+        bool exitsInOrder = r.firstExit == nextExit;
+        nextExit += r.exitCount;
+        if (!refFits(r.name) || !exitsInOrder
+            || std::uint64_t{r.content.offset} + r.content.packedSize > h.contentSize
+            || r.content.packedSize > r.content.rawSize || r.content.rawSize > MAX_CONTENT_SIZE
+            || std::uint64_t{r.firstExit} + r.exitCount > h.exitCount || (r.flags & ~ROOM_GATED) != 0) {
+            error = "world image room " + std::to_string(i) + " out of bounds";
+            return false;
+        }
+    }
+    if (nextExit != h.exitCount) {
+        error = "world image exits not grouped by room";
+        return false;
+    }
+    for (std::uint32_t i = 0; i < h.exitCount; ++i) {
+        auto e = readRecord<ExitRecord>(image, h.exitsOffset + std::size_t{i} * sizeof(ExitRecord));
+        if (e.toRoom >= h.roomCount || !refFits(e.label)) {
+            error = "world image exit " + std::to_string(i) + " out of bounds";
+            return false;
+        }
+    }
+    std::uint64_t nextRoom = 0;   // encounters are in room order, one per room
+    for (std::uint32_t i = 0; i < h.encounterCount; ++i) {
+        auto e = readRecord<EncounterRecord>(image, h.encountersOffset + std::size_t{i} * sizeof(EncounterRecord));
+        if (e.room < nextRoom || e.room >= h.roomCount || e.foe >= ENEMY_TYPE_COUNT
+            || !refFits(e.intro) || !refFits(e.defeat) || !refFits(e.victory)
+            || !refFits(e.lootName) || !refFits(e.lootLook) || !refFits(e.lootSearch)) {
+            error = "world image encounter " + std::to_string(i) + " out of bounds";
+            return false;
+        }
+        nextRoom = std::uint64_t{e.room} + 1;
+    }
+    for (std::uint32_t i = 0; i < h.itemCount; ++i) {
+        auto item = readRecord<ItemRecord>(image, h.itemsOffset + std::size_t{i} * sizeof(ItemRecord));
+        if (item.type >= ITEM_TYPE_COUNT || item.weapon >= WEAPON_TYPE_COUNT
+            || (item.type == static_cast<std::uint32_t>(ItemType::Weapon) && item.value != 0)
+            || !refFits(item.object) || !refFits(item.name) || !refFits(item.description)) {
+            error = "world image item " + std::to_string(i) + " out of bounds";
+            return false;
+        }
+    }
+    std::uint32_t spawnRoom = 0;   // spawns are grouped by room, in id order
+    for (std::uint32_t i = 0; i < h.spawnCount; ++i) {
+        auto sp = readRecord<SpawnRecord>(image, h.spawnsOffset + std::size_t{i} * sizeof(SpawnRecord));
+        if (sp.room < spawnRoom || sp.room >= h.roomCount
+            || !refFits(sp.searchable) || !refFits(sp.name) || !refFits(sp.look) || !refFits(sp.search)) {
+            error = "world image spawn " + std::to_string(i) + " out of bounds";
+            return false;
+        }
+        spawnRoom = sp.room;
+    }
+    return true;
+}
+
+WorldImage::WorldImage(std::string_view validatedImage)
+    : image(validatedImage), head(readRecord<Header>(validatedImage, 0)) {
+    content = image.substr(head.contentOffset, head.contentSize);
+    strings = image.substr(head.stringsOffset, head.stringsSize);
+}
+
+WorldImage::RoomRecord WorldImage::room(std::uint32_t index) const {
+    return readRecord<RoomRecord>(image, head.roomsOffset + std::size_t{index} * sizeof(RoomRecord));
+}
+
+WorldImage::ExitRecord WorldImage::exit(std::uint32_t index) const {
+    return readRecord<ExitRecord>(image, head.exitsOffset + std::size_t{index} * sizeof(ExitRecord));
+}
+
+WorldImage::EncounterRecord WorldImage::encounter(std::uint32_t index) const {
+    return readRecord<EncounterRecord>(image, head.encountersOffset + std::size_t{index} * sizeof(EncounterRecord));
+}
+
+WorldImage::ItemRecord WorldImage::item(std::uint32_t index) const {
+    return readRecord<ItemRecord>(image, head.itemsOffset + std::size_t{index} * sizeof(ItemRecord));
+}
+
+WorldImage::SpawnRecord WorldImage::spawn(std::uint32_t index) const {
+    return readRecord<SpawnRecord>(image, head.spawnsOffset + std::size_t{index} * sizeof(SpawnRecord));
+}
+
+WorldImage::ContentReader::ContentReader() : stream(std::make_unique<Stream>()) {}
+WorldImage::ContentReader::~ContentReader() = default;
+
+bool WorldImage::ContentReader::read(const WorldImage &image, std::uint32_t index, std::string &buffer,
+                                     Content &content) {
+    content.description = std::string_view();
+    content.looks.clear();
+    content.searches.clear();
+
+    RoomRecord r = image.room(index);
+    std::string_view packed = image.packedContent(r);
+    if (r.content.packedSize == r.content.rawSize) {
+        buffer.assign(packed);
+    } else {
+        z_stream &z = stream->z;
+        if (!stream->ready || inflateReset(&z) != Z_OK) return false;
+        buffer.resize(r.content.rawSize);
+        z.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(packed.data()));
+        z.avail_in = static_cast<uInt>(packed.size());
+        z.next_out = reinterpret_cast<Bytef *>(buffer.data());
+        z.avail_out = static_cast<uInt>(buffer.size());
+        if (inflate(&z, Z_FINISH) != Z_STREAM_END || z.total_out != buffer.size()) return false;
+    }
+
+    // Lengths first, then the text they describe
+    std::string_view raw = buffer;
+    constexpr std::size_t FIXED = sizeof(std::uint32_t) + 2 * sizeof(std::uint16_t);
+    if (raw.size() < FIXED) return false;
+    auto descriptionLength = readRecord<std::uint32_t>(raw, 0);
+    auto lookCount = readRecord<std::uint16_t>(raw, 4);
+    auto searchCount = readRecord<std::uint16_t>(raw, 6);
+    std::size_t objects = std::size_t{lookCount} + searchCount;
+    std::size_t at = FIXED + objects * 2 * sizeof(std::uint32_t);
+    if (at > raw.size() || descriptionLength > raw.size() - at) return false;
+    content.description = raw.substr(at, descriptionLength);
+    at += descriptionLength;
+
+    content.looks.reserve(lookCount);
+    content.searches.reserve(searchCount);
+    for (std::size_t i = 0; i < objects; ++i) {
+        auto nameLength = readRecord<std::uint32_t>(raw, FIXED + i * 8);
+        auto textLength = readRecord<std::uint32_t>(raw, FIXED + i * 8 + 4);
+        if (nameLength > raw.size() - at || textLength > raw.size() - at - nameLength) break;
+        DetailText d{raw.substr(at, nameLength), raw.substr(at + nameLength, textLength)};
+        at += std::size_t{nameLength} + textLength;
+
+        auto &run = i < lookCount ? content.looks : content.searches;
+        if (!run.empty() && !(run.back().name < d.name)) break;
+        run.push_back(d);
+    }
+    if (at != raw.size() || content.looks.size() + content.searches.size() != objects) {
+        content.description = std::string_view();
+        content.looks.clear();
+        content.searches.clear();
+        return false;
+    }
+    return true;
+}
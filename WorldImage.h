@@ -0,0 +1,288 @@
+// File: WorldImage.h
+
+#ifndef ZOORK_WORLDIMAGE_H
+#define ZOORK_WORLDIMAGE_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+//
+//  Compiled form of a world description (see longxue.world): everything the
+//  WorldManager needs, laid out so it can be used straight from a read-only
+//  mapping of the file.
+//
+//  Layout (native byte order, all offsets from the start of the image):
+//
+//      Header        72 bytes, magic "ZKWD"
+//      RoomRecord[]  sorted by room name; the index is the RoomId
+//      ExitRecord[]  each room's passages in source order, rooms in id order
+//      EncounterRecord[]  first-arrival fights, at most one per room, in
+//                    room id order; the index is the trigger's number
+//      ItemRecord[]  the things a player can carry, in source order
+//      SpawnRecord[] what searching an object turns up, rooms in id order
+//      content       each room's description and objects, one zlib stream
+//                    per room (stored as-is when that is no larger)
+//      strings       room names, exit labels, encounter, item and spawn
+//                    text, referenced by offset/length
+//
+//  The graph (names and exits) is all that loading a world touches; a
+//  room's text is only unpacked with ContentReader when it is needed.
+//  Unpacked, a room's content is
+//
+//      u32 description length, u16 looks, u16 searches,
+//      (u32 name length, u32 text length) per object,
+//      then the description and each object's name and text
+//
+//  with the looks, then the searches, each sorted by object name.
+//
+//  compile() turns the text format into an image; validate() checks that
+//  every table and reference of an image is in bounds, after which the
+//  record accessors can be used without further checks.  Room content is
+//  checked as it is unpacked.
+//
+class WorldImage {
+public:
+    static constexpr std::uint32_t VERSION = 5;
+
+    // RoomRecord::flags: entering the room may be refused or end the game,
+    // so routes may end there but never pass through it
+    static constexpr std::uint32_t ROOM_GATED = 1;
+
+    // Most encounters one world can have (a session keeps one bit for each)
+    static constexpr std::uint32_t MAX_ENCOUNTERS = 128;
+
+    // Most item definitions one world can have
+    static constexpr std::uint32_t MAX_ITEMS = 4096;
+
+    // Largest unpacked content of one room
+    static constexpr std::uint32_t MAX_CONTENT_SIZE = 1 << 24;
+
+    struct StringRef {
+        std::uint32_t offset;
+        std::uint32_t length;
+    };
+
+    // A room's packed content within the content section
+    struct ContentRef {
+        std::uint32_t offset;
+        std::uint32_t packedSize;   // == rawSize: stored as-is
+        std::uint32_t rawSize;
+    };
+
+    struct Header {
+        char magic[4];
+        std::uint32_t version;
+        std::uint32_t totalSize;
+        std::uint32_t startRoom;
+        std::uint32_t roomCount;
+        std::uint32_t roomsOffset;
+        std::uint32_t exitCount;
+        std::uint32_t exitsOffset;
+        std::uint32_t contentOffset;
+        std::uint32_t contentSize;
+        std::uint32_t stringsOffset;
+        std::uint32_t stringsSize;
+        std::uint32_t encounterCount;
+        std::uint32_t encountersOffset;
+        std::uint32_t itemCount;
+        std::uint32_t itemsOffset;
+        std::uint32_t spawnCount;
+        std::uint32_t spawnsOffset;
+    };
+
+    struct RoomRecord {
+        StringRef name;
+        ContentRef content;
+        std::uint32_t firstExit;
+        std::uint32_t exitCount;
+        std::uint32_t flags;        // ROOM_GATED
+    };
+
+    struct ExitRecord {
+        std::uint32_t toRoom;
+        std::uint32_t reserved;
+        StringRef label;
+    };
+
+    // The fight waiting in `room` on first arrival, and what it leaves behind
+    struct EncounterRecord {
+        std::uint32_t room;
+        std::uint32_t foe;          // an EnemyType
+        StringRef intro;
+        StringRef defeat;
+        StringRef victory;
+        StringRef lootName;
+        StringRef lootLook;
+        StringRef lootSearch;
+    };
+
+    // The item `name` a player gets by taking the object `object`
+    struct ItemRecord {
+        StringRef object;
+        StringRef name;
+        StringRef description;
+        std::uint32_t type;         // an ItemType
+        std::uint32_t weapon;       // a WeaponType, for weapons
+        std::int32_t value;         // armor bonus or heal amount, else 0; weapons
+                                    // always come with a full magazine
+        std::uint32_t reserved;
+    };
+
+    // Searching `searchable` in `room` reveals the object `name`, which can
+    // then be looked at and searched there
+    struct SpawnRecord {
+        std::uint32_t room;
+        std::uint32_t reserved;
+        StringRef searchable;
+        StringRef name;
+        StringRef look;
+        StringRef search;
+    };
+
+    // An encounter's text, as handed to Writer::addEncounter
+    struct EncounterText {
+        std::string_view intro;
+        std::string_view defeat;
+        std::string_view victory;
+        std::string_view lootName;
+        std::string_view lootLook;
+        std::string_view lootSearch;
+    };
+
+    // An object's name and its look or search text
+    struct DetailText {
+        std::string_view name;
+        std::string_view text;
+    };
+
+    // One room's unpacked content; views into the buffer it was unpacked to
+    struct Content {
+        std::string_view description;
+        std::vector<DetailText> looks;      // sorted by name
+        std::vector<DetailText> searches;   // sorted by name
+    };
+
+    // An item, as handed to Writer::addItem
+    struct ItemDefinition {
+        std::string_view object;
+        std::string_view name;
+        std::string_view description;
+        std::uint32_t type;
+        std::uint32_t weapon;
+        std::int32_t value;
+    };
+
+    //
+    //  Unpacks room content, reusing one zlib stream for every room.
+    //
+    class ContentReader {
+    public:
+        ContentReader();
+        ~ContentReader();
+        ContentReader(const ContentReader &) = delete;
+        ContentReader &operator=(const ContentReader &) = delete;
+
+        // Unpack room `index` into `buffer`, with `content` viewing it.
+        // False (and `content` empty) if the room's content is damaged.
+        bool read(const WorldImage &image, std::uint32_t index, std::string &buffer, Content &content);
+
+    private:
+        struct Stream;
+        std::unique_ptr<Stream> stream;
+    };
+
+    //
+    //  Builds an image record by record, for generators that never hold the
+    //  whole world in source form.  Rooms must be added in increasing name
+    //  order (RoomIds are their index); a room's objects, exits, encounter
+    //  and spawns follow its addRoom().  Exits may lead to rooms that are
+    //  added later; items may be added at any point.
+    //
+    class Writer {
+    public:
+        Writer();
+        ~Writer();
+        Writer(const Writer &) = delete;
+        Writer &operator=(const Writer &) = delete;
+
+        std::uint32_t addRoom(std::string_view name, std::string_view description, std::uint32_t flags = 0);
+        void addLook(std::string_view name, std::string_view text);
+        void addSearch(std::string_view name, std::string_view text);
+        void addExit(std::uint32_t toRoom, std::string_view label);
+        // The last room's first-arrival fight; `foe` is an EnemyType
+        void addEncounter(std::uint32_t foe, const EncounterText &text);
+        // What searching `searchable` in the last room reveals
+        void addSpawn(std::string_view searchable, std::string_view name, std::string_view look,
+                      std::string_view search);
+        void addItem(const ItemDefinition &item);
+
+        std::uint32_t roomCount() const { return static_cast<std::uint32_t>(rooms.size()); }
+
+        // Check and lay out everything; false with the reason in `error`
+        bool finish(std::uint32_t startRoom, std::string &image, std::string &error);
+
+    private:
+        struct Stream;
+
+        StringRef addString(std::string_view s);
+        // Pack the last room's description and objects into `content`
+        void flushRoom();
+
+        std::vector<RoomRecord> rooms;
+        std::vector<ExitRecord> exits;
+        std::vector<EncounterRecord> encounters;
+        std::vector<ItemRecord> items;
+        std::vector<SpawnRecord> spawns;
+        std::unordered_set<std::string> itemObjects;   // each taken as one item
+        std::unordered_set<std::string> itemNames;
+        std::string content;
+        std::string strings;
+        std::unordered_map<std::string, StringRef> stringIndex;   // each string stored once
+
+        // The room being added, until flushRoom()
+        std::string description;
+        std::vector<std::pair<std::string, std::string>> looks;
+        std::vector<std::pair<std::string, std::string>> searches;
+        std::string unpacked;
+        std::string packed;
+        std::unique_ptr<Stream> stream;
+
+        std::string lastName;
+        std::string problem;
+    };
+
+    // Text world description to image. On failure returns false with
+    // "line N: ..." in `error`.
+    static bool compile(std::string_view source, std::string &image, std::string &error);
+
+    // Check an image before reading anything else from it
+    static bool validate(std::string_view image, std::string &error);
+
+    // Reader over an image that passed validate(); does not copy it
+    explicit WorldImage(std::string_view validatedImage);
+
+    const Header &header() const { return head; }
+    RoomRecord room(std::uint32_t index) const;
+    ExitRecord exit(std::uint32_t index) const;
+    EncounterRecord encounter(std::uint32_t index) const;
+    ItemRecord item(std::uint32_t index) const;
+    SpawnRecord spawn(std::uint32_t index) const;
+    std::string_view text(StringRef ref) const { return strings.substr(ref.offset, ref.length); }
+    std::string_view packedContent(const RoomRecord &r) const {
+        return content.substr(r.content.offset, r.content.packedSize);
+    }
+
+private:
+    std::string_view image;
+    std::string_view content;
+    std::string_view strings;
+    Header head;
+};
+
+#endif // ZOORK_WORLDIMAGE_H
@@ -2,31 +2,97 @@
 #ifndef ZOORK_WORLDMANAGER_H
 #define ZOORK_WORLDMANAGER_H
 
+#include "ItemRegistry.h"
 #include "Room.h"
+#include "RoomContentStore.h"
+#include "RoomGraph.h"
+#include "RoomTriggers.h"
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <vector>
 
+//
+//  The world as built: rooms, their lore and the passages between them.
+//  Once constructed it is never modified, so one WorldManager can be shared
+//  by every session; what a game changes lives in its WorldOverlay.
+//
+//  Worlds are loaded from compiled images (see WorldImage.h).  Loading
+//  builds only the graph: room names, the RoomGraph of passages, the
+//  encounters waiting in rooms and the ItemRegistry of pickups.  Descriptions and look/search texts stay
+//  packed in the image, which stays mapped for the life of the
+//  WorldManager, and are unpacked into the world's shared RoomContentStore
+//  when a session first needs them.
+//
 class WorldManager {
 public:
-    // Constructor: builds rooms and links them
+    // The built-in world, compiled from longxue.world at build time
     WorldManager();
 
+    // A world image written by ZOOrkWorldc, mapped read-only. Returns
+    // nullptr, with the reason in `error`, if it cannot be used.
+    static std::unique_ptr<WorldManager> loadFile(const std::string &path, std::string &error);
+
+    // A world image built in memory (e.g. by WorldGenerator); the manager
+    // keeps the buffer. Returns nullptr, with the reason in `error`, if the
+    // image is not valid.
+    static std::unique_ptr<WorldManager> fromImage(std::string image, std::string &error);
+
+    ~WorldManager();
+    WorldManager(const WorldManager &) = delete;
+    WorldManager &operator=(const WorldManager &) = delete;
+
     // Return the entry point (starting room)
     std::shared_ptr<Room> getStartingRoom() const;
 
     // Return map of all rooms by name
     const std::map<std::string, std::shared_ptr<Room>>& getAllRooms() const;
 
+    std::size_t getRoomCount() const { return rooms.size(); }
+
+    // Room with the given id, nullptr if out of range
+    Room* getRoomById(RoomId id) const { return graph.getRoom(id); }
+
+    // The passages between the rooms, by RoomId
+    const RoomGraph &getGraph() const { return graph; }
+
+    // Cache of unpacked room text, shared by every session in this world;
+    // it locks internally, so sessions on any thread may use it at once
+    RoomContentStore &getContentStore() const { return *content; }
+
+    // What can be found and taken in this world
+    const ItemRegistry &getItems() const { return items; }
+
+    // Hash of the room names in id order and of which rooms hold
+    // encounters; saved sessions only restore into a world with the same
+    // fingerprint
+    std::uint64_t getFingerprint() const { return fingerprint; }
+
 private:
-    // Create each room and add lore/look/search entries
-    void createRooms();
+    struct Unloaded {};
+    explicit WorldManager(Unloaded) {}
+
+    // Create the rooms and passages of a validated image
+    void build(std::string_view image);
+
+    // The mapped image file, if loaded from one
+    void *mapping = nullptr;
+    std::size_t mappingSize = 0;
+    // The image, if handed over by fromImage()
+    std::string ownedImage;
 
-    // Connect rooms by passages
-    void connectRooms();
+    std::unique_ptr<RoomContentStore> content;
+    ItemRegistry items;
 
     // All rooms, keyed by their name string
     std::map<std::string, std::shared_ptr<Room>> rooms;
+    RoomGraph graph;
+    std::shared_ptr<Room> startRoom;
+    // The image's encounters, by trigger number; rooms point at them
+    std::vector<Encounter> encounters;
+    std::uint64_t fingerprint = 0;
 };
 
-#endif // ZOORK_WORLDMANAGER_H
\ No newline at end of file
+#endif // ZOORK_WORLDMANAGER_H
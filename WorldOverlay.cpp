@@ -0,0 +1,75 @@
+// File: WorldOverlay.cpp
+
+#include "WorldOverlay.h"
+#include <algorithm>
+
+const WorldOverlay::Entry *WorldOverlay::find(RoomId room, Kind kind, std::string_view name) const {
+    for (const Entry &e : entries) {
+        if (e.room == room && e.kind == kind && e.name == name) return &e;
+    }
+    return nullptr;
+}
+
+void WorldOverlay::set(RoomId room, Kind kind, std::string_view name, std::string_view text) {
+    for (Entry &e : entries) {
+        if (e.room == room && e.kind == kind && e.name == name) {
+            e.text.assign(text);
+            return;
+        }
+    }
+    entries.push_back(Entry{room, kind, std::string(name), std::string(text)});
+}
+
+bool WorldOverlay::isLookable(const Room &room, std::string_view name) const {
+    return find(room.getId(), Kind::Look, name) || room.isLookable(name);
+}
+
+bool WorldOverlay::isSearchable(const Room &room, std::string_view name) const {
+    return find(room.getId(), Kind::Search, name) || room.isSearchable(name);
+}
+
+std::string_view WorldOverlay::getLookDescription(const Room &room, std::string_view name) const {
+    if (const Entry *e = find(room.getId(), Kind::Look, name)) return e->text;
+    return room.getLookDescription(name);
+}
+
+std::string_view WorldOverlay::getSearchDescription(const Room &room, std::string_view name) const {
+    if (const Entry *e = find(room.getId(), Kind::Search, name)) return e->text;
+    return room.getSearchDescription(name);
+}
+
+void WorldOverlay::addMatches(RoomId room, Kind kind, std::string_view prefix,
+                              std::vector<std::string_view> &names) const {
+    std::size_t roomNames = names.size();
+    for (const Entry &e : entries) {
+        if (e.room == room && e.kind == kind && std::string_view(e.name).starts_with(prefix)) {
+            names.push_back(e.name);
+        }
+    }
+    // The room's names are already in order; only merge if this session added any
+    if (names.size() == roomNames) return;
+    std::sort(names.begin() + static_cast<std::ptrdiff_t>(roomNames), names.end());
+    std::inplace_merge(names.begin(), names.begin() + static_cast<std::ptrdiff_t>(roomNames), names.end());
+    names.erase(std::unique(names.begin(), names.end()), names.end());
+}
+
+void WorldOverlay::findLookables(const Room &room, std::string_view prefix, std::vector<std::string_view> &names) const {
+    names.clear();
+    room.findLookables(prefix, names);
+    addMatches(room.getId(), Kind::Look, prefix, names);
+}
+
+void WorldOverlay::findSearchables(const Room &room, std::string_view prefix,
+                                   std::vector<std::string_view> &names) const {
+    names.clear();
+    room.findSearchables(prefix, names);
+    addMatches(room.getId(), Kind::Search, prefix, names);
+}
+
+void WorldOverlay::addLookable(const Room &room, std::string_view name, std::string_view lookDesc) {
+    set(room.getId(), Kind::Look, name, lookDesc);
+}
+
+void WorldOverlay::addSearchable(const Room &room, std::string_view name, std::string_view searchDesc) {
+    set(room.getId(), Kind::Search, name, searchDesc);
+}
@@ -0,0 +1,64 @@
+// File: WorldOverlay.h
+
+#ifndef ZOORK_WORLDOVERLAY_H
+#define ZOORK_WORLDOVERLAY_H
+
+#include "Room.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+//
+//  One session's changes to the shared, read-only world: loot left by
+//  fights, items revealed by searching, things the player dropped.
+//
+//  Room contents are looked up here first and fall back to the Room itself,
+//  so every session can play in the same template world.  A game only ever
+//  adds a handful of entries, so they are kept in a flat vector; an empty
+//  overlay costs a few words.
+//
+class WorldOverlay {
+public:
+    bool isLookable(const Room &room, std::string_view name) const;
+    bool isSearchable(const Room &room, std::string_view name) const;
+
+    // Empty string if `name` is not there
+    std::string_view getLookDescription(const Room &room, std::string_view name) const;
+    std::string_view getSearchDescription(const Room &room, std::string_view name) const;
+
+    // Names in `room` starting with `prefix` (all of them for an empty
+    // one), this session's included: sorted, each once
+    void findLookables(const Room &room, std::string_view prefix, std::vector<std::string_view> &names) const;
+    void findSearchables(const Room &room, std::string_view prefix, std::vector<std::string_view> &names) const;
+
+    // Add (or replace) something in `room` for this session only
+    void addLookable(const Room &room, std::string_view name, std::string_view lookDesc);
+    void addSearchable(const Room &room, std::string_view name, std::string_view searchDesc);
+
+    // Forget every change, back to the template world
+    void clear() { entries.clear(); }
+
+    std::size_t size() const { return entries.size(); }
+
+    enum class Kind : std::uint8_t { Look, Search };
+
+    struct Entry {
+        RoomId room;
+        Kind kind;
+        std::string name;
+        std::string text;
+    };
+
+    // Every change, oldest first, and a way to replay one (session snapshots)
+    const std::vector<Entry> &getEntries() const { return entries; }
+    void set(RoomId room, Kind kind, std::string_view name, std::string_view text);
+
+private:
+    const Entry *find(RoomId room, Kind kind, std::string_view name) const;
+    void addMatches(RoomId room, Kind kind, std::string_view prefix, std::vector<std::string_view> &names) const;
+
+    std::vector<Entry> entries;
+};
+
+#endif // ZOORK_WORLDOVERLAY_H
@@ -2,503 +2,580 @@
 
 #include "ZOOrkEngine.h"
 #include "EnemyTypes.h"
-#include "Passage.h"
 #include "Room.h"
+#include "RoomRouter.h"
 #include "Item.h"
+#include "ItemRegistry.h"
 #include "Player.h"
 #include "Weapons.h"
 #include "Combat.h"
 #include <algorithm>
-#include <sstream>
-#include <limits>
-#include <iostream>
-#include <cctype>  // for std::toupper
+#include <charconv>
 
-ZOOrkEngine::ZOOrkEngine(std::shared_ptr<Room> start) {
-    player = Player::instance();
-    player->setCurrentRoom(start.get());
+namespace {
 
-    // Show initial room description and exits
-    start->enter();
-    std::cout << "\nExits:\n";
-    Room* cur = player->getCurrentRoom();
-    for (const auto& kv : cur->getAllExits()) {
-        std::cout << "  - " << kv.second->getTo()->getName() << "\n";
-    }
+// Names the story refers to, interned once
+const Symbol THE_LAB = Symbol::intern("The Lab");
+const Symbol LAB_KEYCARD = Symbol::intern("Lab Keycard");
+const Symbol OVERWRITE_CARD = Symbol::intern("Overwrite Card");
+const Symbol RIFLE = Symbol::intern("Rifle");
+
+// How many names a question or a suggestion lists at most
+constexpr std::size_t MAX_LISTED = 5;
+constexpr std::size_t MAX_SUGGESTIONS = 3;
+
+// Typos forgiven in a name: none in a word of one or two letters, where
+// anything would be "close"
+std::size_t typoLimit(std::string_view typed) {
+    return typed.size() < 3 ? 0 : typed.size() < 6 ? 1 : 2;
 }
 
+} // namespace
+
+ZOOrkEngine::ZOOrkEngine(std::shared_ptr<Room> start, SessionContext& context)
+    : context(context), player(context.getPlayer()), overlay(context.getOverlay()),
+      out(context.getOutput()) {
+    player.setCurrentRoom(start.get());
+}
+
+const std::array<ZOOrkEngine::Handler, static_cast<size_t>(VerbId::Count)> ZOOrkEngine::handlers = {
+    &ZOOrkEngine::handleGoCommand,         // VerbId::Go
+    &ZOOrkEngine::handleTravelCommand,     // VerbId::Travel
+    &ZOOrkEngine::handleLookCommand,       // VerbId::Look
+    &ZOOrkEngine::handleSearchCommand,     // VerbId::Search
+    &ZOOrkEngine::handleTakeCommand,       // VerbId::Take
+    &ZOOrkEngine::handleDropCommand,       // VerbId::Drop
+    &ZOOrkEngine::handleInventoryCommand,  // VerbId::Inventory
+    &ZOOrkEngine::handleHelpCommand,       // VerbId::Help
+    &ZOOrkEngine::handleQuitCommand,       // VerbId::Quit
+};
+
 void ZOOrkEngine::setRoomMap(const std::map<std::string, std::shared_ptr<Room>>& m) {
-    roomMap = m;
+    roomMap = &m;
 }
 
-void ZOOrkEngine::run() {
-    while (!gameOver) {
-        std::cout << "\n> ";
-        std::string input;
-        std::getline(std::cin, input);
-        auto words = tokenizeString(input);
-        if (words.empty()) continue;
+void ZOOrkEngine::reset(std::shared_ptr<Room> start) {
+    player.setCurrentRoom(start.get());
+    input = nullptr;
+    gameOver = false;
+    awaitingCommand = false;
+    firedTriggers.reset();
+}
 
-        std::string command = words[0];
-        std::vector<std::string> arguments(words.begin() + 1, words.end());
+Task ZOOrkEngine::play(LineSource& source) {
+    input = &source;
 
-        if (command == "go" || command == "goto" || command == "move") {
-            handleGoCommand(arguments);
-        }
-        else if (command == "look" || command == "inspect") {
-            handleLookCommand(arguments);
-        }
-        else if (command == "search") {
-            handleSearchCommand(arguments);
-        }
-        else if (command == "take" || command == "get") {
-            handleTakeCommand(arguments);
-        }
-        else if (command == "drop") {
-            handleDropCommand(arguments);
-        }
-        else if (command == "inventory" || command == "inv") {
-            handleInventoryCommand();
-        }
-        else if (command == "help") {
-            handleHelpCommand();
+    // Show initial room description and exits
+    describeRoom(player.getCurrentRoom());
+
+    co_await commandLoop(true);
+}
+
+Task ZOOrkEngine::resume(LineSource& source) {
+    input = &source;
+    co_await commandLoop(false);
+}
+
+Task ZOOrkEngine::commandLoop(bool showPrompt) {
+    while (!gameOver) {
+        if (showPrompt) out.append("\n> ");
+        showPrompt = true;
+
+        awaitingCommand = true;
+        auto line = co_await input->nextLine();
+        awaitingCommand = false;
+        if (!line) {
+            endOfInput();
+            break;
         }
-        else if (command == "quit") {
-            handleQuitCommand(arguments);
+        co_await dispatchCommand(*line);
+    }
+}
+
+void ZOOrkEngine::run(std::istream& in) {
+    StreamLineSource source(in, &out);
+    Task game = play(source);
+    game.start();
+}
+
+void ZOOrkEngine::endOfInput() {
+    // Nothing more will ever arrive, so stop wherever we are
+    if (!gameOver) out.append("\n");
+    gameOver = true;
+}
+
+Task ZOOrkEngine::dispatchCommand(std::string_view line) {
+    commandLine.parse(line);
+    if (commandLine.empty()) co_return;
+
+    std::string_view command = commandLine.verb();
+    CommandArgs arguments = commandLine.arguments();
+
+    if (auto verb = findBuiltinVerb(command)) {
+        co_await (this->*handlers[static_cast<size_t>(*verb)])(arguments);
+    }
+    else if (auto it = extraVerbs.find(command); it != extraVerbs.end()) {
+        if (auto* alias = std::get_if<VerbId>(&it->second)) {
+            co_await (this->*handlers[static_cast<size_t>(*alias)])(arguments);
+        } else {
+            std::get<VerbHandler>(it->second)(arguments);
         }
-        else {
-            // Unrecognized input defaults to look
-            handleLookCommand(words);
+    }
+    else {
+        // Unrecognized input defaults to look
+        co_await handleLookCommand(commandLine.all());
+    }
+}
+
+bool ZOOrkEngine::registerVerb(std::string_view word, VerbId verb) {
+    std::string key(word);
+    lowercaseInPlace(key);
+    if (findBuiltinVerb(key)) return false;
+    extraVerbs[key] = verb;
+    return true;
+}
+
+bool ZOOrkEngine::registerVerb(std::string_view word, VerbHandler handler) {
+    std::string key(word);
+    lowercaseInPlace(key);
+    if (findBuiltinVerb(key)) return false;
+    extraVerbs[key] = std::move(handler);
+    return true;
+}
+
+void ZOOrkEngine::printExits(Room* room) const {
+    // Labels are the destinations' names, and sit together in the graph
+    out.append("Exits:\n");
+    if (const RoomGraph* graph = room->getGraph()) {
+        for (Symbol label : graph->getExitLabels(room->getId())) {
+            out.append("  - ");
+            out.append(label.text());
+            out.append('\n');
         }
     }
 }
 
-void ZOOrkEngine::handleGoCommand(const std::vector<std::string>& arguments) {
+std::string_view ZOOrkEngine::pickName(std::string_view typed, const std::vector<std::string_view>& names) {
+    // An exact name sorts first among those it is a prefix of
+    if (names.empty()) return {};
+    if (names.size() == 1 || names.front() == typed) return names.front();
+    out.append("Which do you mean: ");
+    printNameList(names, names.size());
+    out.append("?\n");
+    return {};
+}
+
+// The room's description, then its exits; the room's text is pinned in
+// the shared content store while it is printed
+void ZOOrkEngine::describeRoom(Room* room) {
+    RoomContentStore::Handle pin = room->pinContent();
+    room->enter(out);
+    out.append("\n");
+    printExits(room);
+}
+
+void ZOOrkEngine::printSuggestions(std::string_view typed, std::vector<std::string_view>& candidates) {
+    std::size_t limit = typoLimit(typed);
+    std::vector<std::pair<std::size_t, std::string_view>> close;
+    std::string lowered;
+    for (std::string_view name : candidates) {
+        lowered.assign(name);
+        lowercaseInPlace(lowered);
+        std::size_t d = editDistance(typed, lowered, limit);
+        if (d <= limit) close.emplace_back(d, name);
+    }
+    std::sort(close.begin(), close.end());
+    if (close.size() > MAX_SUGGESTIONS) close.resize(MAX_SUGGESTIONS);
+
+    candidates.clear();
+    for (const auto& c : close) candidates.push_back(c.second);
+    if (!candidates.empty()) {
+        out.append(" Did you mean ");
+        printNameList(candidates, candidates.size());
+        out.append('?');
+    }
+    out.append('\n');
+}
+
+void ZOOrkEngine::printNameList(std::span<const std::string_view> names, std::size_t total) {
+    std::size_t listed = std::min(names.size(), MAX_LISTED);
+    for (std::size_t i = 0; i < listed; ++i) {
+        if (i > 0) out.append(i + 1 == listed && listed == total ? " or " : ", ");
+        out.print("\"{}\"", names[i]);
+    }
+    if (total > listed) out.print(" or {} more", total - listed);
+}
+
+Task ZOOrkEngine::handleGoCommand(const CommandArgs& arguments) {
     if (arguments.empty()) {
-        std::cout << "Go where?\n";
-        return;
+        out.append("Go where?\n");
+        co_return;
     }
 
-    // Reconstruct the target room name
-    std::string target;
-    for (size_t i = 0; i < arguments.size(); ++i) {
-        if (i > 0) target += " ";
-        target += arguments[i];
-    }
-    std::string targetLower = makeLowercase(target);
-
-    Room* currentRoom = player->getCurrentRoom();
-    bool moved = false;
-
-    // Try each exit
-    for (const auto& kv : currentRoom->getAllExits()) {
-        Room* dest = kv.second->getTo();
-        std::string destNameLower = makeLowercase(dest->getName());
-
-        if (destNameLower == targetLower) {
-            moved = true;
-
-            if (destNameLower == "the lab") {
-                if (!player->hasKeycard("Lab Keycard")) {
-                    std::cout << "Access Denied. Lab Keycard required.\n";
-                    return;
-                }
-                player->dropItem("Lab Keycard");
-                std::cout << "The door seals behind you with a deafening thud.\n"
-                            "A cold, mechanical voice crackles over the speakers:\n\n"
-                            "\"Congratulations, soldier. Through skill and sacrifice you have proven yourself worthy of the gift of immortality.\n"
-                            "The very government you served has traded you to Kiriko as a pawn in their grand design.\n"
-                            "Now you stand at a crossroads:\n\n"
-                            "1) Upload your mind into the network live forever as data, a ghost in their machine.\n"
-                            "2) Use the Overwrite Card to open the escape hatch return to flesh and breathe free air once more.\n"
-                            "3) End your life here refuse this cruel destiny.\n\n"
-                            "Enter 1, 2, or 3: \"";
-
-                int choice;
-                while (true) {
-                    std::cin >> choice;
-                    if (choice >= 1 && choice <= 3) {
-                        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-                        std::cout << "\n";
-                        break;
-                    }
-                    std::cin.clear();
-                    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-                    std::cout << "Invalid choice. Enter 1, 2, or 3: ";
-                }
-
-                switch (choice) {
-                    case 1:
-                        std::cout << "You press the neural uplink button. Pain like a furnace burns your mind as data streams away.\n"
-                                     "Your body collapses. Your consciousness remains trapped in code, immortal but imprisoned.\n";
-                        break;
-
-                    case 2:
-                        if (!player->hasKeycard("Overwrite Card")) {
-                            std::cout << "You slam your hand on the console, but without the Overwrite Card nothing happens.\n"
-                                         "The chamber hums as life support cuts off. You gasp and choke in the failing air.\n";
-                        } else {
-                            player->dropItem("Overwrite Card");
-                            std::cout << "You slide the Overwrite Card into the slot. The hatch snaps open.\n"
-                                         "You crawl through to freedom, lungs burning with cold night air. You're alive for now.\n";
-                        }
-                        break;
-
-                    case 3:
-                        std::cout << "You raise your weapon to your head. No words, no struggle just a single shot. Everything goes black.\n";
-                        break;
-                }
-
-                std::cout << "\n=== END OF LINE ===\n";
-                std::exit(0);
-            }
-            // Normal move
-            player->setCurrentRoom(dest);
-            dest->enter();
-            std::cout << "\nExits:\n";
-            for (const auto& exitPair : dest->getAllExits()) {
-                std::cout << "  - " << exitPair.second->getTo()->getName() << "\n";
-            }
+    // Target room name, already lowercased and single-spaced
+    std::string_view target = arguments.text;
 
-            // --- Zoo combat on first arrival ---
-            if (dest->getName() == "Zoo" && firstArrivalToZoo) {
-                firstArrivalToZoo = false;
-                std::cout << "\nAs you approach the empty pits of the abandoned zoo, a scavenger emerges from the shadows!\n\n";
-
-                auto playerCombatant = std::make_shared<PlayerCombatant>("You");
-                auto rifleItem = player->getInventoryItem("Rifle");
-                if (rifleItem && rifleItem->getWeapon()) {
-                    playerCombatant->equipWeapon(rifleItem->getWeapon());
-                } else {
-                    playerCombatant->equipWeapon(WeaponFactory::createWeapon(WeaponType::Pistol));
-                }
-
-                std::vector<std::shared_ptr<Enemy>> foes;
-                foes.push_back(std::make_shared<Enemy>(EnemyType::Scav));
-
-                CombatManager cm;
-                if (!cm.engage(*playerCombatant, foes)) {
-                    std::cout << "\nYou have been killed in combat. Game Over.\n";
-                    std::exit(0);
-                }
-
-                std::cout << "\nThe scavenger lies still.\n";
-                dest->addLookable("dropped pistol", "A scavenger's pistol lies on the ground.");
-                dest->addSearchable("dropped pistol", "You pick up the dropped Pistol.");
-                std::cout << "\nReentering " << dest->getName() << "...\n\n";
-                dest->enter();
-                std::cout << "\nExits:\n";
-                for (auto& kv2 : dest->getAllExits())
-                    std::cout << "  - " << kv2.second->getTo()->getName() << "\n";
-            }
+    Room* currentRoom = player.getCurrentRoom();
+    const RoomGraph* graph = currentRoom->getGraph();
+    if (!graph) {
+        out.print("You can't go to \"{}\" from here.\n", target);
+        co_return;
+    }
 
-            // --- Lab North Entrance combat on first arrival ---
-            if (dest->getName() == "Lab North Entrance" && firstArrivalToLabNorth) {
-                firstArrivalToLabNorth = false;
-                std::cout << "\nA Japanese PMC squad blocks the Lab North Entrance!\n\n";
-
-                auto playerCombatant = std::make_shared<PlayerCombatant>("You");
-                auto rifleItem = player->getInventoryItem("Rifle");
-                if (rifleItem && rifleItem->getWeapon()) {
-                    playerCombatant->equipWeapon(rifleItem->getWeapon());
-                } else {
-                    playerCombatant->equipWeapon(WeaponFactory::createWeapon(WeaponType::Pistol));
-                }
-
-                std::vector<std::shared_ptr<Enemy>> foes;
-                foes.push_back(std::make_shared<Enemy>(EnemyType::PMC_Japanese));
-
-                CombatManager cm;
-                if (!cm.engage(*playerCombatant, foes)) {
-                    std::cout << "\nYou have been killed by the Japanese PMC squad. Game Over.\n";
-                    std::exit(0);
-                }
-
-                std::cout << "\nThe PMC soldier falls.\n";
-                dest->addLookable("dropped ammo box", "An ammo box stamped with PMC Japanese lies cracked open.");
-                dest->addSearchable("dropped ammo box", "You pick up some usable rounds.");
-                std::cout << "\nReentering " << dest->getName() << "...\n\n";
-                dest->enter();
-                std::cout << "\nExits:\n";
-                for (auto& kv2 : dest->getAllExits())
-                    std::cout << "  - " << kv2.second->getTo()->getName() << "\n";
-            }
+    // Exits are matched by label, which is the destination's name: the
+    // whole of it, or enough to tell it from the others ("go lab c")
+    RoomId from = currentRoom->getId();
+    std::span<const Symbol> labels = graph->getExitLabels(from);
+    auto [first, last] = graph->findExitsByPrefix(from, target);
+    if (first == last) {
+        out.print("You can't go to \"{}\" from here.", target);
+        nameScratch.clear();
+        for (Symbol label : labels) nameScratch.push_back(label.text());
+        printSuggestions(target, nameScratch);
+        co_return;
+    }
+    if (last - first > 1 && labels[first].lower().text() != target) {
+        nameScratch.clear();
+        for (std::size_t e = first; e < last && nameScratch.size() < MAX_LISTED; ++e) {
+            nameScratch.push_back(labels[e].text());
+        }
+        out.append("Which do you mean: ");
+        printNameList(nameScratch, last - first);
+        out.append("?\n");
+        co_return;
+    }
+    co_await moveTo(graph->getRoom(graph->getExits(from)[first]), false);
+}
 
-            // --- Lab Underground Entrance combat on first arrival ---
-            if (dest->getName() == "Lab Underground Entrance" && firstArrivalToLabUnderground) {
-                firstArrivalToLabUnderground = false;
-                std::cout << "\nAs you pry open the bioluminescent door to the underground labs, alarms echo in the corridors!\n\n";
-
-                auto playerCombatant = std::make_shared<PlayerCombatant>("You");
-                auto rifleItem = player->getInventoryItem("Rifle");
-                if (rifleItem && rifleItem->getWeapon()) {
-                    playerCombatant->equipWeapon(rifleItem->getWeapon());
-                } else {
-                    playerCombatant->equipWeapon(WeaponFactory::createWeapon(WeaponType::Pistol));
-                }
-
-                std::vector<std::shared_ptr<Enemy>> foes;
-                foes.push_back(std::make_shared<Enemy>(EnemyType::PMC_Japanese));
-
-                CombatManager cm;
-                if (!cm.engage(*playerCombatant, foes)) {
-                    std::cout << "\nYou have been killed by the Japanese PMC guard. Game Over.\n";
-                    std::exit(0);
-                }
-
-                std::cout << "\nThe PMC guard collapses to the floor.\n";
-                dest->addLookable(
-                    "dropped keycard",
-                    "A Japanese PMC keycard lies on the floor, its chip still warm."
-                );
-                dest->addSearchable(
-                    "dropped keycard",
-                    "You pick up the dropped Lab Keycard."
-                );
-                std::cout << "\nReentering " << dest->getName() << "...\n\n";
-                dest->enter();
-                std::cout << "\nExits:\n";
-                for (auto& kv2 : dest->getAllExits())
-                    std::cout << "  - " << kv2.second->getTo()->getName() << "\n";
-            }
+Task ZOOrkEngine::handleTravelCommand(const CommandArgs& arguments) {
+    if (arguments.empty()) {
+        out.append("Travel where?\n");
+        co_return;
+    }
+    std::string_view target = arguments.text;
 
-            // --- Lab Courtyard combat on first arrival ---
-            if (dest->getName() == "Lab Courtyard" && firstArrivalToLabCourtyard) {
-                firstArrivalToLabCourtyard = false;
-                std::cout << "\nStepping into the overgrown courtyard, a Japanese PMC soldier emerges from cover!\n\n";
-
-                auto playerCombatant = std::make_shared<PlayerCombatant>("You");
-                auto rifleItem = player->getInventoryItem("Rifle");
-                if (rifleItem && rifleItem->getWeapon()) {
-                    playerCombatant->equipWeapon(rifleItem->getWeapon());
-                } else {
-                    playerCombatant->equipWeapon(WeaponFactory::createWeapon(WeaponType::Pistol));
-                }
-
-                std::vector<std::shared_ptr<Enemy>> foes;
-                foes.push_back(std::make_shared<Enemy>(EnemyType::PMC_Japanese));
-
-                CombatManager cm;
-                if (!cm.engage(*playerCombatant, foes)) {
-                    std::cout << "\nThe PMC soldier overpowers you. Game Over.\n";
-                    std::exit(0);
-                }
-
-                std::cout << "\nThe PMC soldier collapses.\n";
-                dest->addLookable(
-                    "dropped rifle",
-                    "A Japanese PMC rifle lies abandoned in the mud."
-                );
-                dest->addSearchable(
-                    "dropped rifle",
-                    "You pick up the dropped Rifle."
-                );
-                std::cout << "\nReentering " << dest->getName() << "...\n\n";
-                dest->enter();
-                std::cout << "\nExits:\n";
-                for (auto& kv2 : dest->getAllExits())
-                    std::cout << "  - " << kv2.second->getTo()->getName() << "\n";
-            }
+    Room* currentRoom = player.getCurrentRoom();
+    const RoomGraph* graph = currentRoom->getGraph();
+    if (!graph) {
+        out.print("There's no place called \"{}\".\n", target);
+        co_return;
+    }
+
+    // Any room in the world, by its name or a prefix only it has
+    const RoomRouter& router = graph->getRouter();
+    std::span<const RoomId> matches = router.findRoomsByPrefix(target);
+    if (matches.empty()) {
+        out.print("There's no place called \"{}\".", target);
+        router.suggestRooms(target, typoLimit(target), roomScratch, routeScratch);
+        nameScratch.clear();
+        for (std::size_t i = 0; i < roomScratch.size() && i < MAX_SUGGESTIONS; ++i) {
+            nameScratch.push_back(graph->getRoom(roomScratch[i])->getName());
+        }
+        printSuggestions(target, nameScratch);
+        co_return;
+    }
+    if (matches.size() > 1 && graph->getRoom(matches.front())->getSymbol().lower().text() != target) {
+        nameScratch.clear();
+        for (std::size_t i = 0; i < matches.size() && i < MAX_LISTED; ++i) {
+            nameScratch.push_back(graph->getRoom(matches[i])->getName());
         }
+        out.append("Which do you mean: ");
+        printNameList(nameScratch, matches.size());
+        out.append("?\n");
+        co_return;
     }
+    RoomId destination = matches.front();
 
-    if (!moved) {
-        std::cout << "You can't go to \"" << target << "\" from here.\n";
+    if (destination == currentRoom->getId()) {
+        out.print("You are already in {}.\n", currentRoom->getName());
+        co_return;
+    }
+    std::vector<RoomId> route;
+    if (!router.findRoute(currentRoom->getId(), destination, route, routeScratch)) {
+        out.print("You can't find a way to {} from here.\n", graph->getRoom(destination)->getName());
+        co_return;
+    }
+
+    // One passage at a time, exactly as "go" would take it; stop wherever
+    // something happens: a fight, a door that stays shut, the end
+    for (std::size_t i = 0; i < route.size(); ++i) {
+        Room* next = graph->getRoom(route[i]);
+        RoomTriggers::Fired fired = firedTriggers;
+        co_await moveTo(next, i + 1 < route.size());
+        if (gameOver || player.getCurrentRoom() != next || firedTriggers != fired) co_return;
     }
 }
 
-void ZOOrkEngine::handleLookCommand(const std::vector<std::string>& arguments) {
-    Room* currentRoom = player->getCurrentRoom();
-    if (arguments.empty()) {
-        std::cout << "\n" << currentRoom->getDescription() << "\n";
-        std::cout << "Exits:\n";
-        for (const auto& kv : currentRoom->getAllExits()) {
-            std::cout << "  - " << kv.second->getTo()->getName() << "\n";
+Task ZOOrkEngine::moveTo(Room* dest, bool passingThrough) {
+    Symbol destName = dest->getSymbol();
+    if (destName.lower() == THE_LAB.lower()) {
+        if (!player.hasKeycard(LAB_KEYCARD)) {
+            out.append("Access Denied. Lab Keycard required.\n");
+            co_return;
         }
-    } else {
-        std::string target;
-        for (size_t i = 0; i < arguments.size(); ++i) {
-            if (i > 0) target += " ";
-            target += arguments[i];
+        player.dropItem(LAB_KEYCARD);
+        out.append("The door seals behind you with a deafening thud.\n"
+                   "A cold, mechanical voice crackles over the speakers:\n\n"
+                   "\"Congratulations, soldier. Through skill and sacrifice you have proven yourself worthy of the gift of immortality.\n"
+                   "The very government you served has traded you to Kiriko as a pawn in their grand design.\n"
+                   "Now you stand at a crossroads:\n\n"
+                   "1) Upload your mind into the network live forever as data, a ghost in their machine.\n"
+                   "2) Use the Overwrite Card to open the escape hatch return to flesh and breathe free air once more.\n"
+                   "3) End your life here refuse this cruel destiny.\n\n"
+                   "Enter 1, 2, or 3: \"");
+        co_await chooseLabEnding();
+        co_return;
+    }
+
+    // The fight that waits here on first arrival, if any
+    const Encounter* encounter = nullptr;
+    std::uint16_t trigger = dest->getTrigger();
+    if (trigger != RoomTriggers::NONE && !firedTriggers.test(trigger)) {
+        firedTriggers.set(trigger);
+        encounter = dest->getEncounter();
+    }
+
+    player.setCurrentRoom(dest);
+    if (passingThrough && !encounter) {
+        out.print("You pass through {}.\n", dest->getName());
+        co_return;
+    }
+    describeRoom(dest);
+
+    if (encounter) {
+        co_await fightEncounter(dest, *encounter);
+    }
+}
+
+Task ZOOrkEngine::chooseLabEnding() {
+    int choice = 0;
+    while (choice < 1 || choice > 3) {
+        auto line = co_await input->nextLine();
+        if (!line) {
+            endOfInput();
+            co_return;
         }
-        if (currentRoom->isLookable(target)) {
-            std::cout << currentRoom->getLookDescription(target) << "\n";
-        } else {
-            std::cout << "There's no \"" << target << "\" to look at here.\n";
+
+        // Same leniency as reading an int with >>: leading blanks are skipped,
+        // blank lines keep waiting, trailing junk after the number is ignored
+        size_t start = line->find_first_not_of(" \t\r");
+        if (start == std::string_view::npos) continue;
+
+        choice = 0;
+        std::from_chars(line->data() + start, line->data() + line->size(), choice);
+        if (choice < 1 || choice > 3) {
+            out.append("Invalid choice. Enter 1, 2, or 3: ");
         }
     }
-}
+    out.append("\n");
+
+    switch (choice) {
+        case 1:
+            out.append("You press the neural uplink button. Pain like a furnace burns your mind as data streams away.\n"
+                       "Your body collapses. Your consciousness remains trapped in code, immortal but imprisoned.\n");
+            break;
+
+        case 2:
+            if (!player.hasKeycard(OVERWRITE_CARD)) {
+                out.append("You slam your hand on the console, but without the Overwrite Card nothing happens.\n"
+                           "The chamber hums as life support cuts off. You gasp and choke in the failing air.\n");
+            } else {
+                player.dropItem(OVERWRITE_CARD);
+                out.append("You slide the Overwrite Card into the slot. The hatch snaps open.\n"
+                           "You crawl through to freedom, lungs burning with cold night air. You're alive for now.\n");
+            }
+            break;
 
+        case 3:
+            out.append("You raise your weapon to your head. No words, no struggle just a single shot. Everything goes black.\n");
+            break;
+    }
 
+    out.append("\n=== END OF LINE ===\n");
+    gameOver = true;
+}
 
-void ZOOrkEngine::handleSearchCommand(const std::vector<std::string>& arguments) {
-    if (arguments.empty()) {
-        std::cout << "Search what?\n";
+Task ZOOrkEngine::fightEncounter(Room* room, const Encounter& encounter) {
+    out.print("\n{}\n\n", encounter.intro);
+
+    auto playerCombatant = std::make_shared<PlayerCombatant>("You", context);
+    // The rifle's ammo and scope live in the item between fights
+    const Item* rifleItem = player.getInventoryItem(RIFLE);
+    bool usingRifle = rifleItem && rifleItem->getItemType() == ItemType::Weapon;
+    auto weapon = usingRifle ? rifleItem->makeWeapon() : WeaponFactory::createWeapon(WeaponType::Pistol);
+    playerCombatant->equipWeapon(weapon);
+
+    CombatManager combat(context);
+    std::vector<EnemyType> foes(1, encounter.foe);
+    co_await combat.engage(*input, std::move(playerCombatant), std::move(foes));
+    if (Item* carried = usingRifle ? player.getInventoryItem(RIFLE) : nullptr) {
+        carried->keepWeaponState(*weapon);
+    }
+    finishEncounter(room, encounter, combat.getOutcome());
+}
+
+void ZOOrkEngine::finishEncounter(Room* room, const Encounter& encounter, CombatManager::Outcome outcome) {
+    if (outcome == CombatManager::Outcome::InputClosed) {
+        endOfInput();
         return;
     }
-    Room* currentRoom = player->getCurrentRoom();
-    std::string target;
-    for (size_t i = 0; i < arguments.size(); ++i) {
-        if (i > 0) target += " ";
-        target += arguments[i];
+    if (outcome == CombatManager::Outcome::Lost) {
+        out.print("\n{}\n", encounter.deathMessage);
+        gameOver = true;
+        return;
     }
 
-    if (currentRoom->isSearchable(target)) {
-        std::cout << currentRoom->getSearchDescription(target) << "\n";
+    out.print("\n{}\n", encounter.victoryMessage);
+    overlay.addLookable(*room, encounter.lootName, encounter.lootLook);
+    overlay.addSearchable(*room, encounter.lootName, encounter.lootSearch);
+    out.print("\nReentering {}...\n\n", room->getName());
+    describeRoom(room);
+}
 
-        if (target == "rifle case") {
-            auto rifle = WeaponFactory::createWeapon(WeaponType::Rifle);
-            currentRoom->addLookable("rifle",   "A sturdy assault rifle leans against the seat.");
-            currentRoom->addSearchable("rifle", "You pick up the Rifle. Damage: 80.");
-        }
-        else if (target == "shotgun rack") {
-            auto shotgun = WeaponFactory::createWeapon(WeaponType::Shotgun);
-            currentRoom->addLookable("shotgun",   "A shotgun rests atop a broken chair.");
-            currentRoom->addSearchable("shotgun", "You pick up the Shotgun. Damage: 60.");
-        }
-        else if (target == "tv rack") {
-            currentRoom->addLookable("lab keycard",   "A Lab Keycard glints on the counter.");
-            currentRoom->addSearchable("lab keycard","You pick up the Lab Keycard; you can now access all Lab entrances.");
+Task ZOOrkEngine::handleLookCommand(const CommandArgs& arguments) {
+    Room* currentRoom = player.getCurrentRoom();
+    RoomContentStore::Handle pin = currentRoom->pinContent();
+    if (arguments.empty()) {
+        out.print("\n{}\n", currentRoom->getDescription(pin));
+        printExits(currentRoom);
+    } else {
+        std::string_view target = arguments.text;
+        overlay.findLookables(*currentRoom, target, nameScratch);
+        if (nameScratch.empty()) {
+            out.print("There's no \"{}\" to look at here.", target);
+            overlay.findLookables(*currentRoom, "", nameScratch);
+            printSuggestions(target, nameScratch);
+            co_return;
         }
-        else if (target == "dead body") {
-            currentRoom->addLookable(
-                "overwrite card",
-                "A sleek Overwrite Card stamped with the Longxue BioTech seal gleams here."
-            );
-            currentRoom->addSearchable(
-                "overwrite card",
-                "You pick up the Overwrite Card."
-            );
+        std::string_view name = pickName(target, nameScratch);
+        if (!name.empty()) {
+            out.print("{}\n", overlay.getLookDescription(*currentRoom, name));
         }
-    } else {
-        std::cout << "You find nothing interesting when searching \"" << target << "\".\n";
     }
+    co_return;
 }
 
-void ZOOrkEngine::handleTakeCommand(const std::vector<std::string>& arguments) {
+
+
+Task ZOOrkEngine::handleSearchCommand(const CommandArgs& arguments) {
     if (arguments.empty()) {
-        std::cout << "Take what?\n";
-        return;
+        out.append("Search what?\n");
+        co_return;
     }
-    std::string target;
-    for (size_t i = 0; i < arguments.size(); ++i) {
-        if (i > 0) target += " ";
-        target += arguments[i];
+    Room* currentRoom = player.getCurrentRoom();
+    RoomContentStore::Handle pin = currentRoom->pinContent();
+
+    // The whole name or a prefix only it has ("search rifle")
+    overlay.findSearchables(*currentRoom, arguments.text, nameScratch);
+    if (nameScratch.empty()) {
+        out.print("You find nothing interesting when searching \"{}\".", arguments.text);
+        overlay.findSearchables(*currentRoom, "", nameScratch);
+        printSuggestions(arguments.text, nameScratch);
+        co_return;
     }
+    // A copy: revealing things below adds to the overlay the name may be in
+    std::string target(pickName(arguments.text, nameScratch));
 
-    Room* currentRoom = player->getCurrentRoom();
-    if (currentRoom->isLookable(target)) {
-        std::string properName;
-        ItemType type;
+    if (!target.empty()) {
+        out.print("{}\n", overlay.getSearchDescription(*currentRoom, target));
 
-        if (target == "rifle" || target == "shotgun" || target == "pistol") {
-            properName = std::string(1, static_cast<char>(std::toupper(target[0]))) + target.substr(1);
-            type = ItemType::Weapon;
-        }
-        else if (target == "lab keycard") {
-            properName = "Lab Keycard";
-            type = ItemType::Keycard;
-        }
-        else if (target == "overwrite card") {
-            properName = "Overwrite Card";
-            type = ItemType::Keycard;
-        }
-        else {
-            std::cout << "You can't pick that up.\n";
-            return;
+        if (const ItemRegistry* items = currentRoom->getItems()) {
+            for (const ItemSpawn& spawn : items->findSpawns(currentRoom->getId(), Symbol::lookup(target))) {
+                overlay.addLookable(*currentRoom, spawn.name, spawn.look);
+                overlay.addSearchable(*currentRoom, spawn.name, spawn.search);
+            }
         }
+    }
+}
 
-        std::shared_ptr<Item> newItem;
-        if (type == ItemType::Weapon) {
-            WeaponType wtype = WeaponType::Pistol;
-            if (properName == "Rifle")        wtype = WeaponType::Rifle;
-            else if (properName == "Shotgun") wtype = WeaponType::Shotgun;
-            else if (properName == "Pistol")  wtype = WeaponType::Pistol;
-
-            newItem = std::make_shared<Item>(
-                properName,
-                "A " + properName + " dropped on the ground.",
-                WeaponFactory::createWeapon(wtype)
-            );
-        } else {
-            newItem = std::make_shared<Item>(
-                properName,
-                "A Keycard stamped with the Longxue BioTech seal.",
-                ItemType::Keycard
-            );
+Task ZOOrkEngine::handleTakeCommand(const CommandArgs& arguments) {
+    if (arguments.empty()) {
+        out.append("Take what?\n");
+        co_return;
+    }
+    std::string_view target = arguments.text;
+
+    Room* currentRoom = player.getCurrentRoom();
+    if (overlay.isLookable(*currentRoom, target)) {
+        const ItemRegistry* items = currentRoom->getItems();
+        std::uint16_t prototype = items ? items->findPrototype(Symbol::lookup(target)) : ItemRegistry::NONE;
+        if (prototype == ItemRegistry::NONE) {
+            out.append("You can't pick that up.\n");
+            co_return;
         }
-
-        if (player->pickUpItem(newItem)) {
-            std::cout << "Picked up: " << properName << "\n";
+        Item newItem(prototype);
+        if (player.pickUpItem(newItem)) {
+            out.print("Picked up: {}\n", newItem.getName());
         }
     } else {
-        std::cout << "There is no \"" << target << "\" here to take.\n";
+        out.print("There is no \"{}\" here to take.\n", target);
     }
 }
 
-void ZOOrkEngine::handleDropCommand(const std::vector<std::string>& arguments) {
+Task ZOOrkEngine::handleDropCommand(const CommandArgs& arguments) {
     if (arguments.empty()) {
-        std::cout << "Drop what?\n";
-        return;
+        out.append("Drop what?\n");
+        co_return;
     }
-    std::string target;
-    for (size_t i = 0; i < arguments.size(); ++i) {
-        if (i > 0) target += " ";
-        target += arguments[i];
+    std::string_view target = arguments.text;
+
+    // The parser lowercases arguments, so match carried items by their
+    // lowercase names the way look/search/take do.
+    Symbol typed = Symbol::lookup(target);
+    std::span<const Symbol> carried = player.getInventory().getNames();
+    auto match = std::find_if(carried.begin(), carried.end(),
+                              [typed](Symbol name) { return name.lower() == typed; });
+    if (match == carried.end() || !player.dropItem(*match)) {
+        out.print("You don't have \"{}\".\n", target);
+        co_return;
     }
 
-    if (player->dropItem(target)) {
-        Room* currentRoom = player->getCurrentRoom();
-        currentRoom->addLookable(target, "A " + target + " lies here on the ground.");
-        currentRoom->addSearchable(target, "You see the " + target + " sitting on the floor.");
-    }
+    Room* currentRoom = player.getCurrentRoom();
+    std::string name(target);
+    overlay.addLookable(*currentRoom, name, "A " + name + " lies here on the ground.");
+    overlay.addSearchable(*currentRoom, name, "You see the " + name + " sitting on the floor.");
 }
 
-void ZOOrkEngine::handleInventoryCommand() {
-    auto contents = player->listInventory();
+Task ZOOrkEngine::handleInventoryCommand(const CommandArgs&) {
+    auto contents = player.listInventory();
     if (contents.empty()) {
-        std::cout << "Your inventory is empty.\n";
+        out.append("Your inventory is empty.\n");
     } else {
-        std::cout << "You are carrying:\n";
-        for (const auto &itemName : contents) {
-            std::cout << "  - " << itemName << "\n";
+        out.append("You are carrying:\n");
+        for (const Item &item : contents) {
+            out.print("  - {}\n", item.getName());
         }
     }
+    co_return;
 }
 
-void ZOOrkEngine::handleHelpCommand() {
-    std::cout << "Available commands:\n";
-    std::cout << "  go <room>            - Move to a connected room (e.g. go Theater)\n";
-    std::cout << "  look [<object>]      - Look around (room description) or at a specific object\n";
-    std::cout << "  search <object>      - Search an object (may reveal items)\n";
-    std::cout << "  take <item>          - Pick up an item after you’ve spawned it\n";
-    std::cout << "  drop <item>          - Drop an item from your inventory\n";
-    std::cout << "  inventory (inv)      - List items you are carrying\n";
-    std::cout << "  help                 - Show this help text\n";
-    std::cout << "  quit                 - Exit the game\n";
-}
-void ZOOrkEngine::handleQuitCommand(const std::vector<std::string>&) {
-    std::string input;
-    std::cout << "Are you sure you want to QUIT? (y/n)\n> ";
-    std::cin >> input;
-    std::string quitStr = makeLowercase(input);
-    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-    if (quitStr == "y" || quitStr == "yes") {
-        gameOver = true;
-    }
+Task ZOOrkEngine::handleHelpCommand(const CommandArgs&) {
+    out.append("Available commands:\n"
+               "  go <room>            - Move to a connected room (e.g. go Theater)\n"
+               "  travel <room>        - Walk the shortest way to any room (e.g. travel Lab Courtyard)\n"
+               "  look [<object>]      - Look around (room description) or at a specific object\n"
+               "  search <object>      - Search an object (may reveal items)\n"
+               "  take <item>          - Pick up an item after you’ve spawned it\n"
+               "  drop <item>          - Drop an item from your inventory\n"
+               "  inventory (inv)      - List items you are carrying\n"
+               "  help                 - Show this help text\n"
+               "  quit                 - Exit the game\n");
+    co_return;
 }
+Task ZOOrkEngine::handleQuitCommand(const CommandArgs&) {
+    out.append("Are you sure you want to QUIT? (y/n)\n> ");
+
+    do {
+        auto line = co_await input->nextLine();
+        if (!line) {
+            endOfInput();
+            co_return;
+        }
+        commandLine.parse(*line);
+    } while (commandLine.empty());  // keep waiting for an answer
 
-std::vector<std::string> ZOOrkEngine::tokenizeString(const std::string &input) {
-    std::vector<std::string> tokens;
-    std::stringstream ss(input);
-    std::string token;
-    while (ss >> token) {
-        tokens.push_back(makeLowercase(token));
+    std::string_view answer = commandLine.verb();
+    if (answer == "y" || answer == "yes") {
+        gameOver = true;
     }
-    return tokens;
 }
-
-std::string ZOOrkEngine::makeLowercase(std::string input) {
-    std::transform(input.begin(), input.end(), input.begin(), ::tolower);
-    return input;
-}
\ No newline at end of file
@@ -3,40 +3,145 @@
 #ifndef ZOORKENGINE_H
 #define ZOORKENGINE_H
 
+#include "Combat.h"
+#include "CommandLine.h"
+#include "LineSource.h"
 #include "Room.h"
+#include "RoomRouter.h"
+#include "RoomTriggers.h"
 #include "Player.h"
+#include "SessionContext.h"
+#include "Task.h"
+#include "VerbTable.h"
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <iostream>
 #include <map>
+#include <memory>
+#include <span>
 #include <string>
+#include <string_view>
+#include <variant>
 #include <vector>
 
 class ZOOrkEngine {
 public:
-    explicit ZOOrkEngine(std::shared_ptr<Room> start);
+    // The engine plays with the context's Player and RNG, records its changes
+    // to the (shared, read-only) rooms in the context's WorldOverlay and
+    // prints to its OutputSink; `context` must outlive it.
+    ZOOrkEngine(std::shared_ptr<Room> start, SessionContext& context);
+    // `m` is the world's own map and must outlive the engine (not copied)
     void setRoomMap(const std::map<std::string, std::shared_ptr<Room>>& m);
-    void run();
+
+    // Get ready for a new game with the same (already reset) context:
+    // back to `start`, all first-arrival fights armed again.
+    // Registered verbs are kept.
+    void reset(std::shared_ptr<Room> start);
+
+    // The whole game as a coroutine: prints the starting room, then awaits
+    // and plays one line of `input` after another (commands, the quit
+    // confirmation, the Lab ending choice, combat actions) until the player
+    // quits, the game ends, or the input closes. `input` must outlive it.
+    Task play(LineSource& input);
+
+    // Carry on a restored game from the command prompt, which the player
+    // has already seen: awaits the next command without printing anything.
+    Task resume(LineSource& input);
+
+    // Play a whole game from a stream (which never suspends), flushing the
+    // output before every read so prompts show up on a terminal.
+    void run(std::istream& input = std::cin);
+
+    bool isGameOver() const { return gameOver; }
+
+    // True while the game waits for a command (not mid-fight or mid-question);
+    // only then does the player, the overlay and the arrival flags below
+    // describe the whole game, so only then can it be saved.
+    bool isAtCommandPrompt() const { return awaitingCommand; }
+
+    // The room triggers that have fired this game (session snapshots)
+    const RoomTriggers::Fired& getFiredTriggers() const { return firedTriggers; }
+    void setFiredTriggers(const RoomTriggers::Fired& fired) { firedTriggers = fired; }
+
+    using VerbHandler = std::function<void(const CommandArgs&)>;
+
+    // Make `word` another alias of a built-in verb (e.g. "walk" -> Go).
+    // Returns false if `word` is already a built-in verb.
+    bool registerVerb(std::string_view word, VerbId verb);
+
+    // Add a new verb with its own handler. Returns false if `word` is
+    // already a built-in verb; re-registering an extra verb replaces it.
+    bool registerVerb(std::string_view word, VerbHandler handler);
 
 private:
-    void handleGoCommand(const std::vector<std::string>& arguments);
-    void handleLookCommand(const std::vector<std::string>& arguments);
-    void handleSearchCommand(const std::vector<std::string>& arguments);
-    void handleTakeCommand(const std::vector<std::string>& arguments);
-    void handleDropCommand(const std::vector<std::string>& arguments);
-    void handleInventoryCommand();
-    void handleHelpCommand();
-    void handleQuitCommand(const std::vector<std::string>& arguments);
-
-    std::vector<std::string> tokenizeString(const std::string& input);
-    std::string makeLowercase(std::string input);
-
-      std::map<std::string, std::shared_ptr<Room>> roomMap;
-    Player* player = nullptr;
+    // Handlers that need further input (go, quit) await it from `input`
+    Task handleGoCommand(const CommandArgs& arguments);
+    Task handleTravelCommand(const CommandArgs& arguments);
+    Task handleLookCommand(const CommandArgs& arguments);
+    Task handleSearchCommand(const CommandArgs& arguments);
+    Task handleTakeCommand(const CommandArgs& arguments);
+    Task handleDropCommand(const CommandArgs& arguments);
+    Task handleInventoryCommand(const CommandArgs& arguments);
+    Task handleHelpCommand(const CommandArgs& arguments);
+    Task handleQuitCommand(const CommandArgs& arguments);
+
+    // Take one passage into `dest`: the Lab's keycard door, the move, then
+    // any first-arrival fight.  A room only passed through on the way
+    // somewhere gets a one-line mention unless a fight waits there.
+    Task moveTo(Room* dest, bool passingThrough);
+
+    Task commandLoop(bool showPrompt);
+    Task dispatchCommand(std::string_view line);
+    Task chooseLabEnding();
+    Task fightEncounter(Room* room, const Encounter& encounter);
+    void finishEncounter(Room* room, const Encounter& encounter, CombatManager::Outcome outcome);
+    void endOfInput();
+    void printExits(Room* room) const;
+    void describeRoom(Room* room);
+
+    // Of `names` (every name starting with what the player typed, in
+    // order), the one meant: the exact name, else the only one.  Asks
+    // which if several fit; empty if it asked or there are none.
+    std::string_view pickName(std::string_view typed, const std::vector<std::string_view>& names);
+
+    // Ends the line of a "not found" message, first offering whichever of
+    // `candidates` are a few typos away from `typed`, closest first (case
+    // aside: `typed` is lowercase)
+    void printSuggestions(std::string_view typed, std::vector<std::string_view>& candidates);
+
+    // `names` quoted and joined ("a", "b" or "c"), with a count of the
+    // `total - names.size()` not listed
+    void printNameList(std::span<const std::string_view> names, std::size_t total);
+
+    // Flat handler table indexed by VerbId
+    using Handler = Task (ZOOrkEngine::*)(const CommandArgs&);
+    static const std::array<Handler, static_cast<size_t>(VerbId::Count)> handlers;
+
+    // Verbs registered at runtime; only consulted when the built-in table
+    // misses. Either an alias of a built-in verb or a handler of its own.
+    std::map<std::string, std::variant<VerbId, VerbHandler>, std::less<>> extraVerbs;
+
+    // Per-session input buffers, reused for every line read
+    CommandLine commandLine;
+    LineSource* input = nullptr;
+
+    // Names matched against the player's words, reused likewise
+    std::vector<std::string_view> nameScratch;
+    std::vector<RoomId> roomScratch;
+    // This session's working space in the world's shared RoomRouter
+    RoomRouter::Scratch routeScratch;
+
+    const std::map<std::string, std::shared_ptr<Room>>* roomMap = nullptr;
+    SessionContext& context;
+    Player& player;
+    WorldOverlay& overlay;   // this game's changes to the shared rooms
+    OutputSink& out;
     bool gameOver = false;
+    bool awaitingCommand = false;
 
-    // one-time arrival flags
-    bool firstArrivalToZoo            = true;
-    bool firstArrivalToLabUnderground = true;
-    bool firstArrivalToLabNorth       = true;
-    bool firstArrivalToLabCourtyard   = true;
+    // One bit per room trigger (see RoomTriggers), set once it has fired
+    RoomTriggers::Fired firedTriggers;
 };
 
-#endif // ZOORKENGINE_H
\ No newline at end of file
+#endif // ZOORKENGINE_H
@@ -0,0 +1,215 @@
+//bench_main.cpp
+#include "LineSource.h"
+#include "RoomContentStore.h"
+#include "SessionContext.h"
+#include "Task.h"
+#include "WorldGenerator.h"
+#include "WorldManager.h"
+#include "ZOOrkEngine.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <malloc.h>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+//
+// Usage: ZOOrkBench [options]
+//
+//   --rooms <n,n,...>          world sizes (1000,10000,100000)
+//   --layouts <l,l,...>        ring, grid and/or smallworld (all three)
+//   --objects <n>              lookable objects per room (4)
+//   --hubs <n>                 hub rooms, the first being the start (1)
+//   --hub-degree <n>           extra passages per hub (256)
+//   --moves <n>                commands per timed run (100000)
+//   --seed <n>                 generator and walk seed (1)
+//   --room-cache <n>           rooms kept unpacked (RoomContentStore default)
+//
+// For every size and layout: generates the world, loads it, then plays the
+// live engine through a PushLineSource and reports nanoseconds per command
+// for a random walk ("go <room>"), for looking at objects and for leaving
+// the start hub by its last passage and coming back.  Memory is the heap
+// taken by the loaded world, image included; "cache" is the share of room
+// text lookups served without unpacking.  Configure the build with
+// -DCMAKE_BUILD_TYPE=Release for numbers worth comparing.
+//
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Clear the collected game text this often; nobody reads it
+constexpr std::size_t DRAIN_EVERY = 1024;
+
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Heap in use (glibc), so memory freed by an earlier run does not hide
+// what the next world takes
+std::size_t heapBytes() {
+    struct mallinfo2 info = ::mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+
+std::vector<std::string> splitList(const char *list) {
+    std::vector<std::string> items;
+    std::string item;
+    for (const char *p = list;; ++p) {
+        if (*p == ',' || *p == '\0') {
+            if (!item.empty()) items.push_back(item);
+            item.clear();
+            if (*p == '\0') break;
+        } else {
+            item += *p;
+        }
+    }
+    return items;
+}
+
+// Feed `commands` to the engine; nanoseconds per command
+double play(PushLineSource &source, OutputSink &out, const std::vector<std::string> &commands) {
+    out.clear();
+    auto start = Clock::now();
+    for (std::size_t i = 0; i < commands.size(); ++i) {
+        source.push(commands[i]);
+        if (i % DRAIN_EVERY == 0) out.clear();
+    }
+    return secondsSince(start) * 1e9 / static_cast<double>(commands.empty() ? 1 : commands.size());
+}
+
+void run(const WorldShape &shape, std::uint32_t moves, std::size_t roomCache) {
+    std::printf("%-10s %8u rooms  ", WorldGenerator::layoutName(shape.layout), shape.rooms);
+    std::fflush(stdout);
+
+    auto start = Clock::now();
+    std::string image;
+    std::string error;
+    if (!WorldGenerator::generate(shape, image, error)) {
+        std::printf("cannot generate: %s\n", error.c_str());
+        return;
+    }
+    double generateSeconds = secondsSince(start);
+    std::size_t imageBytes = image.size();
+
+    std::size_t before = heapBytes() - imageBytes;
+    start = Clock::now();
+    std::unique_ptr<WorldManager> world = WorldManager::fromImage(std::move(image), error);
+    if (!world) {
+        std::printf("cannot load: %s\n", error.c_str());
+        return;
+    }
+    double loadSeconds = secondsSince(start);
+    std::size_t loadedBytes = heapBytes() - before;
+    RoomContentStore &content = world->getContentStore();
+    content.setCapacity(roomCache);
+
+    SessionContext context(shape.seed);
+    OutputSink &out = context.getOutput();
+    ZOOrkEngine engine(world->getStartingRoom(), context);
+    engine.setRoomMap(world->getAllRooms());
+    PushLineSource source;
+    Task game = engine.play(source);
+    game.start();
+
+    // Plan the walk on the world's graph, then time only the engine
+    const RoomGraph &graph = world->getGraph();
+    std::mt19937 rng(shape.seed);
+    std::vector<std::string> commands;
+    commands.reserve(moves);
+    RoomId at = world->getStartingRoom()->getId();
+    for (std::uint32_t i = 0; i < moves && !graph.getExits(at).empty(); ++i) {
+        std::span<const RoomId> exits = graph.getExits(at);
+        at = exits[rng() % exits.size()];
+        commands.push_back("go " + std::string(graph.getRoom(at)->getName()));
+    }
+    double walkNs = play(source, out, commands);
+    bool walkOk = context.getPlayer().getCurrentRoom() == graph.getRoom(at);
+
+    commands.clear();
+    std::vector<std::string> objects = graph.getRoom(at)->getLookableNames();
+    for (std::uint32_t i = 0; i < moves && !objects.empty(); ++i) {
+        commands.push_back("look " + objects[i % objects.size()]);
+    }
+    double lookNs = play(source, out, commands);
+
+    // Out of the start room by its last exit (the longest search) and back
+    commands.clear();
+    Room *hub = world->getStartingRoom().get();
+    std::span<const RoomId> hubExits = graph.getExits(hub->getId());
+    double hubNs = 0;
+    if (!hubExits.empty()) {
+        context.getPlayer().setCurrentRoom(hub);
+        std::string away = "go " + std::string(graph.getRoom(hubExits.back())->getName());
+        std::string back = "go " + std::string(hub->getName());
+        for (std::uint32_t i = 0; i < moves; ++i) commands.push_back(i % 2 ? back : away);
+        hubNs = play(source, out, commands);
+    }
+
+    std::printf("gen %7.3fs  image %7.1f MB  load %7.3fs  mem %7.1f MB  walk %7.0f ns%s  look %6.0f ns  "
+                "hub(%zu exits) %7.0f ns  cache %5.1f%%\n",
+                generateSeconds, imageBytes / 1048576.0, loadSeconds, loadedBytes / 1048576.0, walkNs,
+                walkOk ? "" : " (LOST)", lookNs, hubExits.size(), hubNs,
+                100.0 * content.getHits() / std::max<std::uint64_t>(content.getHits() + content.getMisses(), 1));
+    source.close();
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    WorldShape shape;
+    shape.objectsPerRoom = 4;
+    shape.hubs = 1;
+    shape.hubDegree = 256;
+    std::vector<std::string> sizes = {"1000", "10000", "100000"};
+    std::vector<std::string> layouts = {"ring", "grid", "smallworld"};
+    std::uint32_t moves = 100000;
+    std::size_t roomCache = RoomContentStore::DEFAULT_CAPACITY;
+    bool ok = true;
+    for (int i = 1; i < argc && ok; ++i) {
+        if (i + 1 >= argc) {
+            ok = false;
+        } else if (std::strcmp(argv[i], "--rooms") == 0) {
+            sizes = splitList(argv[++i]);
+        } else if (std::strcmp(argv[i], "--layouts") == 0) {
+            layouts = splitList(argv[++i]);
+        } else if (std::strcmp(argv[i], "--objects") == 0) {
+            shape.objectsPerRoom = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--hubs") == 0) {
+            shape.hubs = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--hub-degree") == 0) {
+            shape.hubDegree = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--moves") == 0) {
+            moves = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--seed") == 0) {
+            shape.seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--room-cache") == 0) {
+            roomCache = static_cast<std::size_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            ok = false;
+        }
+    }
+    for (const std::string &layout : layouts) {
+        ok = ok && WorldGenerator::parseLayout(layout, shape.layout);
+    }
+    if (!ok) {
+        std::cerr << "Usage: " << argv[0]
+                  << " [--rooms <n,...>] [--layouts ring,grid,smallworld] [--objects <n>] [--hubs <n>]"
+                     " [--hub-degree <n>] [--moves <n>] [--seed <n>] [--room-cache <n>]\n";
+        return 2;
+    }
+
+    for (const std::string &layout : layouts) {
+        WorldGenerator::parseLayout(layout, shape.layout);
+        for (const std::string &size : sizes) {
+            shape.rooms = static_cast<std::uint32_t>(std::strtoul(size.c_str(), nullptr, 10));
+            run(shape, moves, roomCache);
+        }
+    }
+    return 0;
+}
@@ -1,12 +1,154 @@
 //main.cpp
+#include "CommandJournal.h"
+#include "LineSource.h"
+#include "SessionContext.h"
+#include "SessionSnapshot.h"
+#include "Task.h"
 #include "WorldManager.h"
 #include "ZOOrkEngine.h"
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unistd.h>
 
-int main() {
-    WorldManager world;
-    std::shared_ptr<Room> start = world.getStartingRoom();
-    ZOOrkEngine zoork(start);
+//
+// Usage:
+//   ZOOrk                     interactive game on the terminal
+//   ZOOrk --script <file>     headless: replay commands from <file> ("-" = stdin)
+//   --seed <n>                fixed RNG seed, so fights replay identically
+//   --restore <file>          start from a saved game instead of a new one
+//   --save <file>             (with --script) when the script runs out, save
+//                             the game to <file> instead of ending it
+//   --journal <file>          append the seed and every input line to the
+//                             journal <file> (see ZOOrkReplay)
+//   --world <file>            play a world image from ZOOrkWorldc instead
+//                             of the built-in one
+//
+// Game text is collected in the session's OutputSink.  On a terminal it is
+// written out once per command, just before waiting for the next line; in
+// headless mode it is only written out in large blocks.
+//
+static constexpr std::size_t SCRIPT_BLOCK_SIZE = 1 << 20;
+
+int main(int argc, char *argv[]) {
+    const char *scriptPath = nullptr;
+    const char *seed = nullptr;
+    const char *savePath = nullptr;
+    const char *restorePath = nullptr;
+    const char *journalPath = nullptr;
+    const char *worldPath = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--script") == 0 && i + 1 < argc) {
+            scriptPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = argv[++i];
+        } else if (std::strcmp(argv[i], "--save") == 0 && i + 1 < argc) {
+            savePath = argv[++i];
+        } else if (std::strcmp(argv[i], "--restore") == 0 && i + 1 < argc) {
+            restorePath = argv[++i];
+        } else if (std::strcmp(argv[i], "--journal") == 0 && i + 1 < argc) {
+            journalPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--world") == 0 && i + 1 < argc) {
+            worldPath = argv[++i];
+        } else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--script <file>|-] [--seed <n>] [--restore <file>] [--save <file>] [--journal <file>] [--world <file>]\n";
+            return 2;
+        }
+    }
+    if (savePath && !scriptPath) {
+        std::cerr << "--save needs --script\n";
+        return 2;
+    }
+    if (journalPath && restorePath) {
+        // A journal replays from the seed, not from a saved game
+        std::cerr << "--journal cannot be combined with --restore\n";
+        return 2;
+    }
+
+    std::unique_ptr<SessionContext> context =
+        seed ? std::make_unique<SessionContext>(static_cast<std::uint32_t>(std::strtoul(seed, nullptr, 10)))
+             : std::make_unique<SessionContext>();
+
+    OutputSink &out = context->getOutput();
+
+    std::unique_ptr<WorldManager> loaded;
+    if (worldPath) {
+        std::string error;
+        loaded = WorldManager::loadFile(worldPath, error);
+        if (!loaded) {
+            std::cerr << "Cannot load world: " << error << "\n";
+            return 1;
+        }
+    } else {
+        loaded = std::make_unique<WorldManager>();
+    }
+    const WorldManager &world = *loaded;
+    ZOOrkEngine zoork(world.getStartingRoom(), *context);
     zoork.setRoomMap(world.getAllRooms());
-    zoork.run();
-    return 0;
+    if (restorePath && !SessionSnapshot::restoreFile(restorePath, world, zoork, *context)) {
+        std::cerr << "Cannot restore saved game: " << restorePath << "\n";
+        return 1;
+    }
+
+    // One session; committed when the game is over
+    CommandJournal journal;
+    std::uint64_t journalSession = 0;
+    if (journalPath) {
+        if (!journal.open(journalPath)) {
+            std::cerr << "Cannot open journal: " << journalPath << "\n";
+            return 1;
+        }
+        journalSession = journal.beginSession(context->getSeed());
+        std::cerr << "Journal session " << journalSession << "\n";
+    }
+
+    if (!scriptPath) {
+        // A restored game starts over from a look at the current room
+        out.attach(STDOUT_FILENO);
+        StreamLineSource source(std::cin, &out);
+        source.journalTo(journalPath ? &journal : nullptr, journalSession);
+        Task game = zoork.play(source);
+        game.start();
+        return out.flush() && journal.commit() ? 0 : 1;
+    }
+
+    std::ifstream scriptFile;
+    std::istream *script = &std::cin;
+    if (std::strcmp(scriptPath, "-") != 0) {
+        scriptFile.open(scriptPath);
+        if (!scriptFile) {
+            std::cerr << "Cannot open script: " << scriptPath << "\n";
+            return 1;
+        }
+        script = &scriptFile;
+    }
+
+    std::ios::sync_with_stdio(false);
+    out.attach(STDOUT_FILENO, SCRIPT_BLOCK_SIZE);
+
+    // A restored game carries on exactly where its script left off
+    PushLineSource source;
+    source.journalTo(journalPath ? &journal : nullptr, journalSession);
+    Task game = restorePath ? zoork.resume(source) : zoork.play(source);
+    game.start();
+
+    std::string line;
+    while (!zoork.isGameOver() && std::getline(*script, line)) {
+        source.push(line);
+    }
+
+    bool ok = true;
+    if (savePath && !zoork.isGameOver()) {
+        ok = out.flush();
+        if (!SessionSnapshot::saveFile(savePath, world, zoork, *context)) {
+            std::cerr << "Cannot save game: " << savePath << "\n";
+            ok = false;
+        }
+    } else {
+        source.close();
+    }
+    return out.flush() && journal.commit() && ok ? 0 : 1;
 }
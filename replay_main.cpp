@@ -0,0 +1,127 @@
+//replay_main.cpp
+#include "CommandJournal.h"
+#include "LineSource.h"
+#include "SessionContext.h"
+#include "Task.h"
+#include "WorldManager.h"
+#include "ZOOrkEngine.h"
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <string_view>
+#include <unistd.h>
+#include <vector>
+
+//
+// Usage:
+//   ZOOrkReplay <journal>             list the sessions in a journal
+//   ZOOrkReplay <journal> <session>   replay one session, printing exactly
+//                                     the game text it produced
+//   --world <file>                    the world image the sessions played
+//                                     (default: the built-in world)
+//
+// A session is rebuilt from its seed and the input lines it consumed, in a
+// fresh context, so its output matches the original byte for byte.
+//
+
+namespace {
+
+struct SessionLog {
+    std::uint32_t seed = 0;
+    bool begun = false;
+    bool closed = false;
+    std::vector<std::string_view> lines;
+};
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    const char *worldPath = nullptr;
+    std::vector<const char *> args;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--world") == 0 && i + 1 < argc) {
+            worldPath = argv[++i];
+        } else {
+            args.push_back(argv[i]);
+        }
+    }
+    if (args.size() != 1 && args.size() != 2) {
+        std::cerr << "Usage: " << argv[0] << " [--world <file>] <journal> [<session>]\n";
+        return 2;
+    }
+
+    std::ifstream file(args[0], std::ios::binary);
+    if (!file) {
+        std::cerr << "Cannot open journal: " << args[0] << "\n";
+        return 1;
+    }
+    std::string image((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    std::map<std::uint64_t, SessionLog> sessions;
+    std::size_t valid = CommandJournal::forEachRecord(image, [&](const CommandJournal::Record &r) {
+        SessionLog &log = sessions[r.session];
+        switch (r.kind) {
+            case CommandJournal::RecordKind::Begin:
+                if (r.payload.size() == sizeof(log.seed)) {
+                    std::memcpy(&log.seed, r.payload.data(), sizeof(log.seed));
+                    log.begun = true;
+                }
+                break;
+            case CommandJournal::RecordKind::Line:
+                log.lines.push_back(r.payload);
+                break;
+            case CommandJournal::RecordKind::Close:
+                log.closed = true;
+                break;
+        }
+    });
+    if (valid < image.size()) {
+        std::cerr << "Ignoring " << image.size() - valid << " bytes of torn journal tail\n";
+    }
+
+    if (args.size() == 1) {
+        for (const auto &kv : sessions) {
+            std::cout << kv.first << "\tseed " << kv.second.seed << "\t" << kv.second.lines.size()
+                      << " lines" << (kv.second.closed ? "\tclosed" : "") << "\n";
+        }
+        return 0;
+    }
+
+    auto it = sessions.find(std::strtoull(args[1], nullptr, 10));
+    if (it == sessions.end() || !it->second.begun) {
+        std::cerr << "No such session: " << args[1] << "\n";
+        return 1;
+    }
+    const SessionLog &log = it->second;
+
+    SessionContext context(log.seed);
+    OutputSink &out = context.getOutput();
+    out.attach(STDOUT_FILENO);
+
+    std::unique_ptr<WorldManager> world;
+    if (worldPath) {
+        std::string error;
+        world = WorldManager::loadFile(worldPath, error);
+        if (!world) {
+            std::cerr << "Cannot load world: " << error << "\n";
+            return 1;
+        }
+    } else {
+        world = std::make_unique<WorldManager>();
+    }
+    ZOOrkEngine zoork(world->getStartingRoom(), context);
+    zoork.setRoomMap(world->getAllRooms());
+
+    PushLineSource source;
+    Task game = zoork.play(source);
+    game.start();
+    for (std::string_view line : log.lines) {
+        source.push(line);
+    }
+    if (log.closed) source.close();
+    return out.flush() ? 0 : 1;
+}
@@ -0,0 +1,80 @@
+//server_main.cpp
+#include "GameServer.h"
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+//
+// Usage: ZOOrkServer [--port <n>] [--journal <file>] [--world <file>]
+//                    [--spill-dir <dir>] [--hibernate-after <ms>] [--max-resident <n>]
+//                    [--room-cache <n>]
+//
+// Serves one independent game per TCP connection on 127.0.0.1 (default
+// port 4000). Each connection plays exactly what `ZOOrk` plays on a
+// terminal: send command lines, read the game text back.
+// With --journal, every session can be replayed with ZOOrkReplay.
+// Idle games are parked in a spill file under --spill-dir (default /tmp;
+// "" turns hibernation off).  --room-cache is how many rooms' text all
+// sessions keep unpacked between them (default 4096).
+//
+
+static GameServer *activeServer = nullptr;
+
+static void onSignal(int) {
+    if (activeServer) activeServer->stop();
+}
+
+int main(int argc, char *argv[]) {
+    GameServer::Options options;
+    const char *worldPath = nullptr;
+    std::size_t roomCache = RoomContentStore::DEFAULT_CAPACITY;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--port") == 0 && i + 1 < argc) {
+            options.port = static_cast<std::uint16_t>(std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--journal") == 0 && i + 1 < argc) {
+            options.journalPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--world") == 0 && i + 1 < argc) {
+            worldPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--spill-dir") == 0 && i + 1 < argc) {
+            options.spillDirectory = argv[++i];
+        } else if (std::strcmp(argv[i], "--hibernate-after") == 0 && i + 1 < argc) {
+            options.hibernateAfterMs = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--max-resident") == 0 && i + 1 < argc) {
+            options.maxResident = static_cast<std::size_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--room-cache") == 0 && i + 1 < argc) {
+            roomCache = static_cast<std::size_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--port <n>] [--journal <file>] [--world <file>] [--spill-dir <dir>]"
+                      << " [--hibernate-after <ms>] [--max-resident <n>] [--room-cache <n>]\n";
+            return 2;
+        }
+    }
+
+    std::shared_ptr<const WorldManager> world;
+    if (worldPath) {
+        std::string error;
+        world = WorldManager::loadFile(worldPath, error);
+        if (!world) {
+            std::cerr << "Cannot load world: " << error << "\n";
+            return 1;
+        }
+    } else {
+        world = std::make_shared<const WorldManager>();
+    }
+    world->getContentStore().setCapacity(roomCache);
+
+    GameServer server(options, std::move(world));
+    if (!server.start()) {
+        return 1;
+    }
+
+    activeServer = &server;
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+
+    std::cerr << "ZOOrkServer listening on 127.0.0.1:" << server.boundPort() << "\n";
+    server.run();
+    activeServer = nullptr;
+    return 0;
+}
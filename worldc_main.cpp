@@ -0,0 +1,87 @@
+//worldc_main.cpp
+#include "WorldImage.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+
+//
+// Usage: ZOOrkWorldc <world file> -o <image> [--cpp <source> <symbol>]
+//
+// Compiles a world description (see longxue.world) into the binary image
+// the games load with --world.  With --cpp it also writes a C++ source
+// defining `const unsigned char <symbol>[]` and `std::size_t <symbol>Size`
+// with the image, which is how the built-in world gets into the binaries.
+//
+
+static bool writeFile(const std::string &path, const std::string &data) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(data.data(), static_cast<std::streamsize>(data.size()));
+    return static_cast<bool>(out.flush());
+}
+
+static std::string cppSource(const std::string &image, const std::string &symbol, const char *from) {
+    std::string src;
+    src.reserve(image.size() * 5 + 256);
+    const char *slash = std::strrchr(from, '/');
+    src += "// Generated by ZOOrkWorldc from ";
+    src += slash ? slash + 1 : from;
+    src += "; do not edit.\n#include <cstddef>\n\nextern const unsigned char " + symbol + "[] = {";
+    char hex[8];
+    for (std::size_t i = 0; i < image.size(); ++i) {
+        if (i % 16 == 0) src += "\n   ";
+        std::snprintf(hex, sizeof(hex), " 0x%02x,", static_cast<unsigned char>(image[i]));
+        src += hex;
+    }
+    src += "\n};\nextern const std::size_t " + symbol + "Size = sizeof(" + symbol + ");\n";
+    return src;
+}
+
+int main(int argc, char *argv[]) {
+    const char *sourcePath = nullptr;
+    const char *imagePath = nullptr;
+    const char *cppPath = nullptr;
+    const char *symbol = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            imagePath = argv[++i];
+        } else if (std::strcmp(argv[i], "--cpp") == 0 && i + 2 < argc) {
+            cppPath = argv[++i];
+            symbol = argv[++i];
+        } else if (!sourcePath && argv[i][0] != '-') {
+            sourcePath = argv[i];
+        } else {
+            sourcePath = nullptr;
+            break;
+        }
+    }
+    if (!sourcePath || !imagePath) {
+        std::cerr << "Usage: " << argv[0] << " <world file> -o <image> [--cpp <source> <symbol>]\n";
+        return 2;
+    }
+
+    std::ifstream in(sourcePath, std::ios::binary);
+    if (!in) {
+        std::cerr << "Cannot open world file: " << sourcePath << "\n";
+        return 1;
+    }
+    std::string source((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    std::string image;
+    std::string error;
+    if (!WorldImage::compile(source, image, error)) {
+        std::cerr << sourcePath << ": " << error << "\n";
+        return 1;
+    }
+    if (!writeFile(imagePath, image)) {
+        std::cerr << "Cannot write world image: " << imagePath << "\n";
+        return 1;
+    }
+    if (cppPath && !writeFile(cppPath, cppSource(image, symbol, sourcePath))) {
+        std::cerr << "Cannot write C++ source: " << cppPath << "\n";
+        return 1;
+    }
+    return 0;
+}